@@ -9,7 +9,7 @@
 #include "iso8211.h"
 
 #include <cstring>
-#include <iostream>
+#include <cstdint>
 
 using namespace std;
 using namespace Standards;
@@ -36,9 +36,38 @@ const DDFSubfieldDefining* DDFFieldDefining::FindSubfieldDefining(const string &
     return nullptr;
 }
 
+const DDFSubfieldHandle DDFFieldDefining::GetSubfieldHandle(const string &mnemonicTag) const noexcept {
+    DDFSubfieldHandle subfieldHandle;
+    subfieldHandle.fieldDefining = this;
+    subfieldHandle.isFixedOffset = true;
+
+    const auto &&subfieldDefiningsSize = subfieldDefinings.size();
+
+    for (auto idx = 0ul; idx < subfieldDefiningsSize; ++idx) {
+        auto &&subfieldDefining = subfieldDefinings[idx];
+
+        if (subfieldDefining->GetName() == mnemonicTag) {
+            subfieldHandle.subfieldIdx = idx;
+            subfieldHandle.subfieldDefining = subfieldDefining;
+
+            return subfieldHandle;
+        }
+
+        if (subfieldDefining->GetWidth()) {
+            subfieldHandle.subfieldOffset += subfieldDefining->GetWidth();
+        } else {
+            subfieldHandle.isFixedOffset = false;
+        }
+    }
+
+    return DDFSubfieldHandle();
+}
+
 bool DDFFieldDefining::BuildSubfields(const char*& descriptorArray, const size_t& descriptorArrayLenght, const char*& formatControls, const size_t& formatControlsLenght) noexcept {
     if (formatControlsLenght < 2 || formatControls[0] != '(' || formatControls[formatControlsLenght - 1] != ')') {
-        cout << "WARNING: Format controls for '" << tagName << "' field missing brackets: " << formatControls << endl;
+        if (DDFDiagnostics::Report(DDF_DC_DEFINITION)) {
+            DDFDiagnostics::Post(DDF_DC_DEFINITION, "Format controls for '" + string(tagName) + "' field missing brackets: " + string(formatControls, formatControlsLenght));
+        }
         return false;
     }
 
@@ -89,27 +118,159 @@ bool DDFFieldDefining::BuildSubfields(const char*& descriptorArray, const size_t
         }
     }
 
+    subfieldOffsets.reserve(subfieldDefinings.size());
+
     for(auto&& subfueld : subfieldDefinings) {
         if(!subfueld->GetWidth()) {
             fixedWidth = 0;
+            subfieldOffsets.clear();
             break;
         } else {
+            subfieldOffsets.push_back(fixedWidth);
             fixedWidth += subfueld->GetWidth();
         }
     }
 
+    BuildDecodePlan();
+
     return true;
 }
 
+void DDFFieldDefining::BuildDecodePlan() noexcept {
+    decodePlan.clear();
+    decodePlan.reserve(subfieldDefinings.size());
+
+    for (auto &&subfield : subfieldDefinings) {
+        DDFDecodeOp decodeOp;
+        decodeOp.dataType = subfield->GetDataType();
+        decodeOp.width = subfield->GetWidth();
+        decodeOp.isVariable = subfield->IsVariable();
+        decodeOp.subfieldDefining = subfield;
+
+        switch (subfield->GetFormat()) {
+            case 'A':
+                decodeOp.opcode = DDF_OP_TEXT;
+                break;
+            case 'I':
+                decodeOp.opcode = DDF_OP_TEXT_INT;
+                break;
+            case 'R':
+                decodeOp.opcode = DDF_OP_TEXT_FLOAT;
+                break;
+            case 'B':
+                decodeOp.opcode = DDF_OP_BIT_STRING;
+                break;
+            case 'b':
+                switch (subfield->GetBinaryFormat()) {
+                    case DDF_BF_UINT:
+                        decodeOp.opcode = decodeOp.width == 4 ? DDF_OP_UINT32 : decodeOp.width == 2 ? DDF_OP_UINT16 : decodeOp.width == 1 ? DDF_OP_UINT8 : DDF_OP_SKIP;
+                        break;
+                    case DDF_BF_SINT:
+                        decodeOp.opcode = decodeOp.width == 4 ? DDF_OP_SINT32 : decodeOp.width == 2 ? DDF_OP_SINT16 : decodeOp.width == 1 ? DDF_OP_SINT8 : DDF_OP_SKIP;
+                        break;
+                    case DDF_BF_FLOAT_REAL:
+                        decodeOp.opcode = decodeOp.width == 8 ? DDF_OP_FLOAT64 : decodeOp.width == 4 ? DDF_OP_FLOAT32 : DDF_OP_SKIP;
+                        break;
+                    default:
+                        decodeOp.opcode = DDF_OP_SKIP;
+                        break;
+                }
+                break;
+            default:
+                decodeOp.opcode = DDF_OP_SKIP;
+                break;
+        }
+
+        decodePlan.push_back(decodeOp);
+    }
+}
+
+const size_t DDFFieldDefining::DecodeField(const byte *sourceData, const size_t &dataSize, DDFSubfieldValue *values) const noexcept {
+    size_t offset = 0ul;
+    const auto &&planSize = decodePlan.size();
+
+    for (auto idx = 0ul; idx < planSize; ++idx) {
+        auto &&decodeOp = decodePlan[idx];
+        auto &&value = values[idx];
+
+        const auto &&dataLeft = offset < dataSize ? dataSize - offset : 0ul;
+        auto subfieldData = sourceData + offset;
+
+        value.longValue = 0l;
+        value.doubleValue = 0.0;
+
+        if (decodeOp.isVariable) {
+            size_t consumedBytes = 0ul;
+            value.binaryData = DDFBinaryView(subfieldData, dataLeft ? decodeOp.subfieldDefining->GetDataLenght(subfieldData, dataLeft, &consumedBytes) : 0ul);
+            offset += consumedBytes;
+        } else {
+            value.binaryData = DDFBinaryView(subfieldData, min(decodeOp.width, dataLeft));
+            offset += decodeOp.width;
+
+            if (value.binaryData.size < decodeOp.width) {
+                continue;
+            }
+        }
+
+        switch (decodeOp.opcode) {
+            case DDF_OP_TEXT_INT:
+                value.longValue = DDFTextToLong(DDFStringView(reinterpret_cast<const char*>(subfieldData), value.binaryData.size));
+                break;
+            case DDF_OP_TEXT_FLOAT:
+                value.doubleValue = DDFTextToDouble(DDFStringView(reinterpret_cast<const char*>(subfieldData), value.binaryData.size));
+                value.longValue = static_cast<long>(value.doubleValue);
+                continue;
+            case DDF_OP_UINT8:
+                value.longValue = subfieldData[0];
+                break;
+            case DDF_OP_UINT16:
+                value.longValue = subfieldData[0] | (subfieldData[1] << 8);
+                break;
+            case DDF_OP_UINT32:
+                value.longValue = static_cast<long>(static_cast<uint32_t>(subfieldData[0]) | (static_cast<uint32_t>(subfieldData[1]) << 8) | (static_cast<uint32_t>(subfieldData[2]) << 16) | (static_cast<uint32_t>(subfieldData[3]) << 24));
+                break;
+            case DDF_OP_SINT8:
+                value.longValue = static_cast<int8_t>(subfieldData[0]);
+                break;
+            case DDF_OP_SINT16:
+                value.longValue = static_cast<int16_t>(subfieldData[0] | (subfieldData[1] << 8));
+                break;
+            case DDF_OP_SINT32:
+                value.longValue = static_cast<int32_t>(static_cast<uint32_t>(subfieldData[0]) | (static_cast<uint32_t>(subfieldData[1]) << 8) | (static_cast<uint32_t>(subfieldData[2]) << 16) | (static_cast<uint32_t>(subfieldData[3]) << 24));
+                break;
+            case DDF_OP_FLOAT32: {
+                float floatValue = 0.0f;
+                memcpy(&floatValue, subfieldData, sizeof(floatValue));
+                value.doubleValue = floatValue;
+                value.longValue = static_cast<long>(floatValue);
+                continue;
+            }
+            case DDF_OP_FLOAT64:
+                memcpy(&value.doubleValue, subfieldData, sizeof(value.doubleValue));
+                value.longValue = static_cast<long>(value.doubleValue);
+                continue;
+            default:
+                continue;
+        }
+
+        value.doubleValue = static_cast<double>(value.longValue);
+    }
+
+    return offset;
+}
+
 DDFFieldDefining* DDFFieldDefining::Initialize(const ulong& fieldControlLenght, const ulong& sizeFieldTag, char *tagName, const ulong& fieldEntrySize, const char *binaryData) noexcept {
     auto newFieldDefining = new DDFFieldDefining;
 
     size_t fieldDefiningOffset = fieldControlLenght;
     newFieldDefining->tagName = DDFStringUpper(tagName);
+    newFieldDefining->fieldTag = DDFPackTag(newFieldDefining->tagName, sizeFieldTag);
 
     switch (binaryData[0]) {
         default:
-            cout << "WARNING: Unrecognised data structure code '" << binaryData[0] << "'." << endl << "Field " << tagName << " initialization incorrect." << endl;
+            if (DDFDiagnostics::Report(DDF_DC_DEFINITION)) {
+                DDFDiagnostics::Post(DDF_DC_DEFINITION, "Unrecognised data structure code '" + string(1ul, binaryData[0]) + "', field " + string(tagName) + " initialization incorrect.");
+            }
         case ' ':
         case '0':
             newFieldDefining->dataStructureCode = DDF_DSC_ELEMENTARY;
@@ -127,7 +288,9 @@ DDFFieldDefining* DDFFieldDefining::Initialize(const ulong& fieldControlLenght,
 
     switch (binaryData[1]) {
         default:
-            cout << "WARNING: Unrecognised data type code '" << binaryData[1] << "'." << endl << "Field " << tagName << " initialization incorrect." << endl;
+            if (DDFDiagnostics::Report(DDF_DC_DEFINITION)) {
+                DDFDiagnostics::Post(DDF_DC_DEFINITION, "Unrecognised data type code '" + string(1ul, binaryData[1]) + "', field " + string(tagName) + " initialization incorrect.");
+            }
         case ' ':
         case '0':
             newFieldDefining->dataTypeCode = DDF_DTC_CHAR_STRING;
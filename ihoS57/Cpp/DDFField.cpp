@@ -8,6 +8,10 @@
 
 #include "iso8211.h"
 
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
 using namespace Standards;
 
 const long DDFField::GetSubfieldAsLong(const string &sufieldName, const ulong fieldIdx) const noexcept {
@@ -18,6 +22,9 @@ const long DDFField::GetSubfieldAsLong(const string &sufieldName, const ulong fi
     
     size_t bytesLeft = 0ull;
     auto&& subfieldData = GetBinaryData(subfield, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return 0l;
     
     return subfield->ExtractDataAsLong(subfieldData, bytesLeft);
 }
@@ -30,6 +37,9 @@ const double DDFField::GetSubfieldAsDouble(const string &sufieldName, const ulon
     
     size_t bytesLeft = 0ull;
     auto&& subfieldData = GetBinaryData(subfield, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return 0.0;
     
     return subfield->ExtractDataAsDouble(subfieldData, bytesLeft);
 }
@@ -42,6 +52,9 @@ const char* DDFField::GetSubfieldAsString(const string &sufieldName, const ulong
     
     size_t bytesLeft = 0ull;
     auto&& subfieldData = GetBinaryData(subfield, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return nullptr;
     
     return subfield->ExtractDataAsString(subfieldData, bytesLeft);
 }
@@ -55,12 +68,52 @@ const byte* DDFField::GetSubfieldAsBinary(const string &sufieldName, const ulong
     return GetBinaryData(subfield, fieldIdx);
 }
 
+const long DDFField::GetSubfieldAsLong(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfieldHandle, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return 0l;
+
+    return subfieldHandle.subfieldDefining->ExtractDataAsLong(subfieldData, bytesLeft);
+}
+
+const double DDFField::GetSubfieldAsDouble(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfieldHandle, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return 0.0;
+
+    return subfieldHandle.subfieldDefining->ExtractDataAsDouble(subfieldData, bytesLeft);
+}
+
+const char* DDFField::GetSubfieldAsString(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfieldHandle, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return nullptr;
+
+    return subfieldHandle.subfieldDefining->ExtractDataAsString(subfieldData, bytesLeft);
+}
+
+const byte* DDFField::GetSubfieldAsBinary(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    return GetBinaryData(subfieldHandle, fieldIdx);
+}
+
 const byte* DDFField::GetBinaryData(const DDFSubfieldDefining *&subfieldDef, const ulong &fieldIdx, size_t *byteLeft) const noexcept {
     size_t consumedBytes = 0ul;
     size_t offset = 0ul;
     
-    if (fieldIdx && fieldDefining->GetFixedWidth()) {
-        offset = fieldDefining->GetFixedWidth() * fieldIdx;
+    const auto &&fixedWidth = fieldDefining->GetFixedWidth();
+
+    if (fieldIdx) {
+        offset = GetRepeatOffset(fieldIdx);
+    }
+
+    if (offset >= dataSize) {
+        return nullptr;
     }
     
     const auto &&fieldDefiningCount = fieldDefining->GetSubfieldCount();
@@ -69,6 +122,15 @@ const byte* DDFField::GetBinaryData(const DDFSubfieldDefining *&subfieldDef, con
         auto &&subfield = fieldDefining->GetSubfieldDefining(idx);
         
         if (subfield == subfieldDef) {
+            if (fixedWidth) {
+                offset += fieldDefining->GetSubfieldOffset(idx);
+            }
+
+            // A field cut short by it's directory entry may end before the subfield.
+            if (offset >= dataSize) {
+                return nullptr;
+            }
+
             if (byteLeft) {
                 *byteLeft = dataSize - offset;
             }
@@ -76,13 +138,176 @@ const byte* DDFField::GetBinaryData(const DDFSubfieldDefining *&subfieldDef, con
             return binaryData + offset;
         }
         
-        subfield->GetDataLenght(binaryData + offset, dataSize - offset, &consumedBytes);
-        offset += consumedBytes;
+        if (!fixedWidth) {
+            subfield->GetDataLenght(binaryData + offset, dataSize - offset, &consumedBytes);
+            offset += consumedBytes;
+
+            if (offset >= dataSize) {
+                break;
+            }
+        }
     }
     
     return nullptr;
 }
 
+const DDFStringView DDFField::GetSubfieldAsStringView(const string &sufieldName, const ulong fieldIdx) const noexcept {
+    auto&& subfield = fieldDefining->FindSubfieldDefining(sufieldName);
+
+    if (!subfield)
+        return DDFStringView();
+
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfield, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return DDFStringView();
+
+    return subfield->ExtractDataAsStringView(subfieldData, bytesLeft);
+}
+
+const DDFStringView DDFField::GetSubfieldAsStringView(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfieldHandle, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return DDFStringView();
+
+    return subfieldHandle.subfieldDefining->ExtractDataAsStringView(subfieldData, bytesLeft);
+}
+
+const DDFBinaryView DDFField::GetSubfieldAsBinaryView(const string &sufieldName, const ulong fieldIdx) const noexcept {
+    auto&& subfield = fieldDefining->FindSubfieldDefining(sufieldName);
+
+    if (!subfield)
+        return DDFBinaryView();
+
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfield, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return DDFBinaryView();
+
+    return subfield->ExtractDataAsBinaryView(subfieldData, bytesLeft);
+}
+
+const DDFBinaryView DDFField::GetSubfieldAsBinaryView(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx) const noexcept {
+    size_t bytesLeft = 0ull;
+    auto&& subfieldData = GetBinaryData(subfieldHandle, fieldIdx, &bytesLeft);
+
+    if (!subfieldData)
+        return DDFBinaryView();
+
+    return subfieldHandle.subfieldDefining->ExtractDataAsBinaryView(subfieldData, bytesLeft);
+}
+
+const size_t DDFField::GetSubfieldAsLongArray(const DDFSubfieldHandle &subfieldHandle, vector<long> &values) const noexcept {
+    values.clear();
+
+    if (!subfieldHandle.subfieldDefining || subfieldHandle.fieldDefining != fieldDefining) {
+        return 0ul;
+    }
+
+    const auto &&repeatCount = GetRepeatCount();
+    const auto &&fixedWidth = fieldDefining->GetFixedWidth();
+
+    if (!fixedWidth) {
+        for (auto idx = 0ul; idx < repeatCount; ++idx) {
+            values.push_back(GetSubfieldAsLong(subfieldHandle, idx));
+        }
+
+        return values.size();
+    }
+
+    auto &&subfield = subfieldHandle.subfieldDefining;
+    const auto &&subfieldWidth = subfield->GetWidth();
+    const auto &&subfieldOffset = fieldDefining->GetSubfieldOffset(subfieldHandle.subfieldIdx);
+
+    if (subfieldOffset + subfieldWidth > fixedWidth) {
+        return 0ul;
+    }
+
+    values.resize(repeatCount);
+
+    auto repeatData = binaryData + subfieldOffset;
+
+    if (subfieldWidth == 4 && subfield->GetBinaryFormat() == DDF_BF_SINT) {
+        int32_t value = 0;
+
+        for (auto idx = 0ul; idx < repeatCount; ++idx, repeatData += fixedWidth) {
+            memcpy(&value, repeatData, sizeof(value));
+            values[idx] = value;
+        }
+    } else if (subfieldWidth == 4 && subfield->GetBinaryFormat() == DDF_BF_UINT) {
+        uint32_t value = 0u;
+
+        for (auto idx = 0ul; idx < repeatCount; ++idx, repeatData += fixedWidth) {
+            memcpy(&value, repeatData, sizeof(value));
+            values[idx] = value;
+        }
+    } else {
+        for (auto idx = 0ul; idx < repeatCount; ++idx, repeatData += fixedWidth) {
+            values[idx] = subfield->ExtractDataAsLong(repeatData, dataSize - (repeatData - binaryData));
+        }
+    }
+
+    return repeatCount;
+}
+
+const size_t DDFField::DecodeRepeats(vector<DDFSubfieldValue> &values) const noexcept {
+    const auto &&subfieldCount = fieldDefining->GetSubfieldCount();
+
+    if (!subfieldCount) {
+        values.clear();
+
+        return 0ul;
+    }
+
+    const auto &&repeatCount = GetRepeatCount();
+    values.resize(repeatCount * subfieldCount);
+
+    for (auto idx = 0ul; idx < repeatCount; ++idx) {
+        const auto offset = min(GetRepeatOffset(idx), dataSize);
+
+        fieldDefining->DecodeField(binaryData + offset, dataSize - offset, &values[idx * subfieldCount]);
+    }
+
+    return repeatCount;
+}
+
+const byte* DDFField::GetBinaryData(const DDFSubfieldHandle &subfieldHandle, const ulong &fieldIdx, size_t *byteLeft) const noexcept {
+    if (!subfieldHandle.subfieldDefining || subfieldHandle.fieldDefining != fieldDefining) {
+        return nullptr;
+    }
+
+    size_t offset = 0ul;
+
+    if (fieldIdx) {
+        offset = GetRepeatOffset(fieldIdx);
+    }
+
+    if (subfieldHandle.isFixedOffset) {
+        offset += subfieldHandle.subfieldOffset;
+    } else {
+        size_t consumedBytes = 0ul;
+
+        for (auto idx = 0ul; idx < subfieldHandle.subfieldIdx && offset < dataSize; ++idx) {
+            fieldDefining->GetSubfieldDefining(idx)->GetDataLenght(binaryData + offset, dataSize - offset, &consumedBytes);
+            offset += consumedBytes;
+        }
+    }
+
+    if (offset >= dataSize) {
+        return nullptr;
+    }
+
+    if (byteLeft) {
+        *byteLeft = dataSize - offset;
+    }
+
+    return binaryData + offset;
+}
+
 const size_t DDFField::GetRepeatCount() const noexcept {
     if (!fieldDefining->isRepiting()) {
         return 1ul;
@@ -91,6 +316,77 @@ const size_t DDFField::GetRepeatCount() const noexcept {
     if (fieldDefining->GetFixedWidth()) {
         return dataSize / fieldDefining->GetFixedWidth();
     }
+
+    ScanRepeats();
     
-    return 1ul;
+    return max(static_cast<size_t>(1ul), repeatOffsets.size());
+}
+
+const byte* DDFField::GetRepeatData(const ulong &fieldIdx, size_t *byteLeft) const noexcept {
+    const auto &&offset = GetRepeatOffset(fieldIdx);
+
+    if (offset >= dataSize) {
+        return nullptr;
+    }
+
+    if (byteLeft) {
+        *byteLeft = dataSize - offset;
+    }
+
+    return binaryData + offset;
+}
+
+void DDFField::Initialize(const DDFFieldDefining *fieldDefining, const size_t fieldEntrySize, const byte *pachFieldArea) noexcept {
+    this->fieldDefining = fieldDefining;
+    dataSize = fieldEntrySize;
+    binaryData = pachFieldArea;
+
+    isRepeatScanned = false;
+    repeatOffsets.clear();
+}
+
+void DDFField::ScanRepeats() const noexcept {
+    if (isRepeatScanned) {
+        return;
+    }
+
+    isRepeatScanned = true;
+    repeatOffsets.clear();
+
+    const auto &&subfieldCount = fieldDefining->GetSubfieldCount();
+    if (!subfieldCount) {
+        return;
+    }
+
+    size_t offset = 0ul;
+    size_t consumedBytes = 0ul;
+
+    // A repeat holds at least one byte per subfield, so what is left of the
+    // field terminator (two bytes at lexical level 2) can't start one.
+    while (offset < dataSize && dataSize - offset > subfieldCount && !(dataSize - offset <= 2ul && binaryData[offset] == DDF_FIELD_TERMINATOR)) {
+        repeatOffsets.push_back(offset);
+
+        for (auto idx = 0ul; idx < subfieldCount && offset < dataSize; ++idx) {
+            fieldDefining->GetSubfieldDefining(idx)->GetDataLenght(binaryData + offset, dataSize - offset, &consumedBytes);
+            offset += max(static_cast<size_t>(1ul), consumedBytes);
+        }
+    }
+}
+
+const size_t DDFField::GetRepeatOffset(const ulong &fieldIdx) const noexcept {
+    if (!fieldIdx) {
+        return 0ul;
+    }
+
+    if (!fieldDefining->isRepiting()) {
+        return dataSize;
+    }
+
+    if (fieldDefining->GetFixedWidth()) {
+        return fieldDefining->GetFixedWidth() * fieldIdx;
+    }
+
+    ScanRepeats();
+
+    return fieldIdx < repeatOffsets.size() ? repeatOffsets[fieldIdx] : dataSize;
 }
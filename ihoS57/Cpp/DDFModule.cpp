@@ -10,40 +10,128 @@
 
 #include <fstream>
 #include <cstring>
-#include <iostream>
+#include <cstdint>
+#include <mutex>
 
 using namespace std;
 using namespace Standards;
 
-const bool DDFModule::Open(const string& fileName, const bool testOpen) noexcept {
+static const char DDFIndexSignature[4] = { 'D', 'D', 'F', 'I' };
+static const uint32_t DDFIndexVersion = 1u;
 
-    if (DDFfileBuf.tellp()) {
+/**
+ * Process wide cache of the DDRs read, at most DDF_DDR_CACHE_SIZE of them.
+ */
+struct DDFDescriptiveCache {
+    mutex cacheMutex;
+    vector<shared_ptr<const DDFDescriptiveRecord>> descriptiveRecords;
+};
+
+static DDFDescriptiveCache &DDFGetDescriptiveCache() noexcept {
+    static DDFDescriptiveCache descriptiveCache;
+
+    return descriptiveCache;
+}
+
+static size_t DDFHashRecord(const byte *recordData, const size_t &recordLenght) noexcept {
+    uint64_t recordHash = 0xCBF29CE484222325ull;
+
+    for (auto idx = 0ul; idx < recordLenght; ++idx) {
+        recordHash = (recordHash ^ recordData[idx]) * 0x100000001B3ull;
+    }
+
+    return static_cast<size_t>(recordHash);
+}
+
+const bool DDFModule::Open(const string& fileName, const bool testOpen, const DDFopenMode openMode) noexcept {
+
+    if (fileData) {
         Close();
     }
 
-    fstream fileDDF(fileName, ios::binary | ios::in);
+    if (openMode == DDF_OM_MAPPED) {
+        fileData = DDFMapFile(fileName, &fileSize);
+    } else if (openMode == DDF_OM_STREAMED) {
+        auto fileStream = new ifstream(fileName, ios::binary | ios::in);
+
+        if (fileStream->is_open()) {
+            isStreamOwner = true;
+            inputStream = fileStream;
+            streamOrigin = fileStream->tellg();
+
+            streamCapacity = DDF_STREAM_BUFFER_SIZE;
+            fileData = streamBuffer = new byte[streamCapacity];
+        } else {
+            delete fileStream;
+            fileStream = nullptr;
+        }
+    } else {
+        fstream fileDDF(fileName, ios::binary | ios::in | ios::ate);
+
+        if (fileDDF.is_open()) {
+            fileSize = static_cast<size_t>(fileDDF.tellg());
+
+            auto fileBuffer = new byte[fileSize + 1]();
+            fileDDF.seekg(0, ios::beg);
+
+            if (fileDDF.read(reinterpret_cast<char*>(fileBuffer), fileSize)) {
+                fileData = fileBuffer;
+            } else {
+                delete [] fileBuffer;
+                fileBuffer = nullptr;
+            }
+
+            fileDDF.close();
+        }
+    }
 
-    if (!fileDDF.is_open()) {
+    if (!fileData) {
         if (!testOpen) {
-            cout << "WARNING: Unable to open DDF file '" << fileName << "'." << endl;
+            if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+                DDFDiagnostics::Post(DDF_DC_FILE, "Unable to open DDF file '" + fileName + "'.");
+            }
         }
 
+        fileSize = 0ul;
+
         return false;
     }
 
-    char strBuffer[DDF_LEADER_SIZE];
-    DDFfileBuf << fileDDF.rdbuf();
-    fileDDF.close();
+    this->openMode = openMode;
+
+    return ReadDescriptiveRecord(fileName);
+}
 
-    if (!DDFfileBuf.read(strBuffer, DDF_LEADER_SIZE)) {
-        cout << "WARNING: Leader is short on DDF file '" << fileName << "'." << endl;
+const bool DDFModule::Open(istream &inputStream, const size_t bufferSize) noexcept {
+
+    if (fileData) {
+        Close();
+    }
+
+    openMode = DDF_OM_STREAMED;
+
+    this->inputStream = &inputStream;
+    streamOrigin = inputStream.tellg();
+
+    streamCapacity = max(bufferSize, static_cast<size_t>(DDF_LEADER_SIZE));
+    fileData = streamBuffer = new byte[streamCapacity];
+
+    return ReadDescriptiveRecord("input stream");
+}
+
+const bool DDFModule::ReadDescriptiveRecord(const string &fileName) noexcept {
+    if (LoadData(DDF_LEADER_SIZE) < DDF_LEADER_SIZE) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "Leader is short on DDF file '" + fileName + "'.");
+        }
 
         Close();
 
         return false;
     }
 
-    recordLenght = DDFScanInt(strBuffer, 5);
+    auto strBuffer = reinterpret_cast<const char*>(fileData + fileOffset);
+
     interchangeLevel = strBuffer[5];
 
     leaderIdentifier = strBuffer[6];
@@ -51,34 +139,53 @@ const bool DDFModule::Open(const string& fileName, const bool testOpen) noexcept
     versionNumber = strBuffer[8];
     applicationIndicator = strBuffer[9];
 
-    fieldControlLenght = DDFScanInt(strBuffer + 10, 2);
-    fieldAreaStart = DDFScanInt(strBuffer + 12, 5);
-
     memcpy(extendedCharSet, strBuffer + 17, 3);
 
-    sizeFieldLenght = DDFScanInt(strBuffer + 20, 1);
-    sizeFieldPosition = DDFScanInt(strBuffer + 21, 1);
-    sizeFieldTag = DDFScanInt(strBuffer + 23, 1);
+    size_t leaderValues[6] = { 0ul, 0ul, 0ul, 0ul, 0ul, 0ul };
+    const auto &&isLeaderValid = DDFParseInt(strBuffer, 5, &leaderValues[0]) && DDFParseInt(strBuffer + 10, 2, &leaderValues[1]) && DDFParseInt(strBuffer + 12, 5, &leaderValues[2]) &&
+                                 DDFParseInt(strBuffer + 20, 1, &leaderValues[3]) && DDFParseInt(strBuffer + 21, 1, &leaderValues[4]) && DDFParseInt(strBuffer + 23, 1, &leaderValues[5]);
 
-    if (recordLenght < DDF_LEADER_SIZE || !fieldControlLenght || fieldAreaStart < 24 || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
-        cout << "WARNING: File '" << fileName << "' does not appear to have a valid ISO 8211 header." << endl;
+    recordLenght = static_cast<uint>(leaderValues[0]);
+    fieldControlLenght = static_cast<uint>(leaderValues[1]);
+    fieldAreaStart = static_cast<uint>(leaderValues[2]);
+    sizeFieldLenght = static_cast<uint>(leaderValues[3]);
+    sizeFieldPosition = static_cast<uint>(leaderValues[4]);
+    sizeFieldTag = static_cast<uint>(leaderValues[5]);
+
+    if (!isLeaderValid || recordLenght < DDF_LEADER_SIZE || !fieldControlLenght || fieldAreaStart < 24 || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "File '" + fileName + "' does not appear to have a valid ISO 8211 header.");
+        }
 
         Close();
 
         return false;
     }
 
-    const auto &&pachRecordLenght = recordLenght - DDF_LEADER_SIZE;
-    auto pachRecord = new char[pachRecordLenght + 1]();
-
-    if (!DDFfileBuf.read(pachRecord, pachRecordLenght)) {
-        cout << "WARNING: Header record is short on DDF file '" << fileName << "'." << endl;
+    if (LoadData(recordLenght) < recordLenght) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "Header record is short on DDF file '" + fileName + "'.");
+        }
 
         Close();
 
         return false;
     }
 
+    const auto recordHash = DDFHashRecord(fileData + fileOffset, recordLenght);
+
+    if ((descriptiveRecord = FindDescriptiveRecord(fileData + fileOffset, recordLenght, recordHash))) {
+        fileOffset += recordLenght;
+        indexedOffset = firstRecordOffset = recordLenght;
+
+        return true;
+    }
+
+    shared_ptr<DDFDescriptiveRecord> newRecord(new DDFDescriptiveRecord);
+
+    const auto &&pachRecordLenght = recordLenght - DDF_LEADER_SIZE;
+    auto pachRecord = reinterpret_cast<const char*>(fileData + fileOffset + DDF_LEADER_SIZE);
+
     const auto &&fieldEntryWidth = sizeFieldLenght + sizeFieldPosition + sizeFieldTag;
     for (auto idx = 0ul; idx < pachRecordLenght && pachRecord[idx] != DDF_FIELD_TERMINATOR; idx += fieldEntryWidth) {
         auto entryOffset = idx;
@@ -87,22 +194,22 @@ const bool DDFModule::Open(const string& fileName, const bool testOpen) noexcept
         memcpy(tagName, pachRecord + entryOffset, sizeFieldTag);
 
         entryOffset += sizeFieldTag;
-        auto fieldLenght = static_cast<ulong>(DDFScanInt(pachRecord + entryOffset, sizeFieldLenght));
+        size_t fieldLenght = 0ul;
+        size_t fieldPosition = 0ul;
 
-        entryOffset += sizeFieldLenght;
-        auto fieldPosition = DDFScanInt(pachRecord + entryOffset, sizeFieldPosition);
+        const auto &&isEntryValid = DDFParseInt(pachRecord + entryOffset, static_cast<byte>(sizeFieldLenght), &fieldLenght) &&
+                                    DDFParseInt(pachRecord + entryOffset + sizeFieldLenght, static_cast<byte>(sizeFieldPosition), &fieldPosition);
 
         const auto fieldOffset = fieldAreaStart + fieldPosition - DDF_LEADER_SIZE;
-        if ((recordLenght - fieldOffset) < fieldLenght) {
-            cout << "WARNING: Header record invalid on DDF file '" << fileName << "'." << endl;
+        if (!isEntryValid || fieldOffset > pachRecordLenght || (pachRecordLenght - fieldOffset) < fieldLenght) {
+            if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+                DDFDiagnostics::Post(DDF_DC_FILE, "Header record invalid on DDF file '" + fileName + "'.");
+            }
 
             Close();
 
             delete [] tagName;
             tagName = nullptr;
-            
-            delete [] pachRecord;
-            pachRecord = nullptr;
 
             return false;
         }
@@ -110,18 +217,230 @@ const bool DDFModule::Open(const string& fileName, const bool testOpen) noexcept
         auto field = DDFFieldDefining::Initialize(fieldControlLenght, sizeFieldTag, tagName, fieldLenght, pachRecord + fieldOffset);
 
         if (field) {
-            fieldDefinings[tagName] = field;
+            newRecord->AddFieldDefining(field);
+        }
+    }
+
+    newRecord->BuildTagTable();
+    newRecord->recordData.assign(reinterpret_cast<const char*>(fileData + fileOffset), recordLenght);
+    newRecord->recordHash = recordHash;
+
+    descriptiveRecord = CacheDescriptiveRecord(newRecord);
+
+    fileOffset += recordLenght;
+    indexedOffset = firstRecordOffset = recordLenght;
+
+    return true;
+}
+
+const bool DDFModule::IndexRecord(const size_t &recordOffset) noexcept {
+    if (recordOffset >= fileSize || fileSize - recordOffset < DDF_LEADER_SIZE) {
+        isIndexComplete = true;
+
+        return false;
+    }
+
+    auto strBuffer = reinterpret_cast<const char*>(fileData + recordOffset);
+
+    size_t recordLenght = 0ul;
+    size_t fieldAreaStart = 0ul;
+    size_t sizeFieldLenght = 0ul;
+    size_t sizeFieldPosition = 0ul;
+    size_t sizeFieldTag = 0ul;
+
+    const auto &&isLeaderValid = DDFParseInt(strBuffer, 5, &recordLenght) && DDFParseInt(strBuffer + 12, 5, &fieldAreaStart) &&
+                                 DDFParseInt(strBuffer + 20, 1, &sizeFieldLenght) && DDFParseInt(strBuffer + 21, 1, &sizeFieldPosition) && DDFParseInt(strBuffer + 23, 1, &sizeFieldTag);
+
+    if (!isLeaderValid || fieldAreaStart <= DDF_LEADER_SIZE || recordLenght < fieldAreaStart || recordLenght > fileSize - recordOffset || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
+        isIndexComplete = true;
+
+        return false;
+    }
+
+    DDFRecordIndexEntry recordEntry;
+    recordEntry.recordOffset = recordOffset;
+    recordEntry.recordLenght = recordLenght;
+
+    const auto fieldEntryWidth = sizeFieldLenght + sizeFieldPosition + sizeFieldTag;
+    const auto fieldEntryCount = (fieldAreaStart - DDF_LEADER_SIZE - 1) / fieldEntryWidth;
+
+    auto fieldEntry = strBuffer + DDF_LEADER_SIZE;
+    if (fieldEntryCount > 1 && sizeFieldTag == 4 && !memcmp(fieldEntry, "0001", 4)) {
+        fieldEntry += fieldEntryWidth;
+    }
+
+    if (fieldEntryCount) {
+        memcpy(recordEntry.fieldTag, fieldEntry, min(sizeFieldTag, static_cast<size_t>(DDF_INDEX_TAG_SIZE)));
+    }
+
+    recordIndex.push_back(recordEntry);
+
+    indexedOffset = recordOffset + recordLenght;
+
+    // The records following a reused leader have no leader of their own and can't be indexed.
+    isIndexComplete = indexedOffset >= fileSize || strBuffer[6] == 'R';
+
+    return true;
+}
+
+const bool DDFModule::BuildIndex() noexcept {
+    if (!fileData || openMode == DDF_OM_STREAMED) {
+        return false;
+    }
+
+    while (!isIndexComplete && IndexRecord(indexedOffset));
+
+    return indexedOffset == fileSize;
+}
+
+vector<size_t> DDFModule::FindRecords(const string &fieldName) noexcept {
+    vector<size_t> recordIdxs;
+
+    if (!BuildIndex() && recordIndex.empty()) {
+        return recordIdxs;
+    }
+
+    char fieldTag[DDF_INDEX_TAG_SIZE] = { '\0', '\0', '\0', '\0' };
+    memcpy(fieldTag, fieldName.data(), min(fieldName.size(), static_cast<size_t>(DDF_INDEX_TAG_SIZE)));
+
+    const auto &&recordCount = recordIndex.size();
+    for (auto idx = 0ul; idx < recordCount; ++idx) {
+        if (!memcmp(recordIndex[idx].fieldTag, fieldTag, DDF_INDEX_TAG_SIZE)) {
+            recordIdxs.push_back(idx);
+        }
+    }
+
+    return recordIdxs;
+}
+
+const bool DDFModule::SaveIndex(const string &indexName) noexcept {
+    if (!BuildIndex()) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "Unable to build the record index for '" + indexName + "'.");
+        }
+
+        return false;
+    }
+
+    ofstream indexFile(indexName, ios::binary | ios::out | ios::trunc);
+
+    if (!indexFile.is_open()) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "Unable to create DDF index file '" + indexName + "'.");
+        }
+
+        return false;
+    }
+
+    const uint64_t indexHeader[3] = { fileSize, firstRecordOffset, recordIndex.size() };
+
+    indexFile.write(DDFIndexSignature, sizeof(DDFIndexSignature));
+    indexFile.write(reinterpret_cast<const char*>(&DDFIndexVersion), sizeof(DDFIndexVersion));
+    indexFile.write(reinterpret_cast<const char*>(indexHeader), sizeof(indexHeader));
+
+    for (auto &&recordEntry : recordIndex) {
+        const uint64_t recordLocation[2] = { recordEntry.recordOffset, recordEntry.recordLenght };
+
+        indexFile.write(reinterpret_cast<const char*>(recordLocation), sizeof(recordLocation));
+        indexFile.write(recordEntry.fieldTag, DDF_INDEX_TAG_SIZE);
+    }
+
+    return indexFile.good();
+}
+
+const bool DDFModule::LoadIndex(const string &indexName) noexcept {
+    if (!fileData || openMode == DDF_OM_STREAMED) {
+        return false;
+    }
+
+    ifstream indexFile(indexName, ios::binary | ios::in);
+
+    if (!indexFile.is_open()) {
+        return false;
+    }
+
+    char indexSignature[sizeof(DDFIndexSignature)];
+    uint32_t indexVersion = 0u;
+    uint64_t indexHeader[3] = { 0ull, 0ull, 0ull };
+
+    indexFile.read(indexSignature, sizeof(indexSignature));
+    indexFile.read(reinterpret_cast<char*>(&indexVersion), sizeof(indexVersion));
+    indexFile.read(reinterpret_cast<char*>(indexHeader), sizeof(indexHeader));
+
+    if (!indexFile || memcmp(indexSignature, DDFIndexSignature, sizeof(DDFIndexSignature)) || indexVersion != DDFIndexVersion || indexHeader[0] != fileSize || indexHeader[1] != firstRecordOffset) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "DDF index file '" + indexName + "' doesn't match the open file.");
         }
+
+        return false;
     }
 
-    firstRecordOffset = DDFfileBuf.tellg();
+    vector<DDFRecordIndexEntry> loadedIndex(static_cast<size_t>(indexHeader[2]));
+    auto expectedOffset = firstRecordOffset;
+
+    for (auto &&recordEntry : loadedIndex) {
+        uint64_t recordLocation[2] = { 0ull, 0ull };
+        size_t leaderRecordLenght = 0ul;
+
+        indexFile.read(reinterpret_cast<char*>(recordLocation), sizeof(recordLocation));
+        indexFile.read(recordEntry.fieldTag, DDF_INDEX_TAG_SIZE);
+
+        recordEntry.recordOffset = static_cast<size_t>(recordLocation[0]);
+        recordEntry.recordLenght = static_cast<size_t>(recordLocation[1]);
 
-    delete [] pachRecord;
-    pachRecord = nullptr;
+        if (!indexFile || recordEntry.recordOffset != expectedOffset || recordEntry.recordLenght < DDF_LEADER_SIZE || recordEntry.recordLenght > fileSize - expectedOffset ||
+            !DDFParseInt(reinterpret_cast<const char*>(fileData + expectedOffset), 5, &leaderRecordLenght) || leaderRecordLenght != recordEntry.recordLenght) {
+            if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+                DDFDiagnostics::Post(DDF_DC_FILE, "DDF index file '" + indexName + "' is corrupt.");
+            }
+
+            return false;
+        }
+
+        expectedOffset += recordEntry.recordLenght;
+    }
+
+    recordIndex.swap(loadedIndex);
+
+    indexedOffset = expectedOffset;
+    isIndexComplete = true;
 
     return true;
 }
 
+const size_t DDFModule::LoadData(const size_t &byteCount) noexcept {
+    auto bytesLeft = fileSize - fileOffset;
+
+    if (bytesLeft >= byteCount || openMode != DDF_OM_STREAMED || !inputStream) {
+        return bytesLeft;
+    }
+
+    if (fileOffset) {
+        memmove(streamBuffer, streamBuffer + fileOffset, bytesLeft);
+
+        fileSize = bytesLeft;
+        fileOffset = 0ul;
+    }
+
+    if (byteCount > streamCapacity) {
+        auto newBuffer = new byte[byteCount];
+        memcpy(newBuffer, streamBuffer, fileSize);
+
+        delete [] streamBuffer;
+        fileData = streamBuffer = newBuffer;
+        streamCapacity = byteCount;
+    }
+
+    inputStream->read(reinterpret_cast<char*>(streamBuffer + fileSize), byteCount - fileSize);
+    fileSize += static_cast<size_t>(inputStream->gcount());
+
+    if (*inputStream && fileSize < streamCapacity) {
+        fileSize += static_cast<size_t>(inputStream->readsome(reinterpret_cast<char*>(streamBuffer + fileSize), streamCapacity - fileSize));
+    }
+
+    return fileSize;
+}
+
 const DDFRecord *DDFModule::ReadRecord() noexcept {
     if (!currentRecord) {
         currentRecord = new DDFRecord(*this);
@@ -129,35 +448,305 @@ const DDFRecord *DDFModule::ReadRecord() noexcept {
 
     return currentRecord->Read() ? currentRecord : nullptr;
 }
+
+const DDFRecord *DDFModule::ReadRecord(const DDFRecordFilter &recordFilter) noexcept {
+    if (!currentRecord) {
+        currentRecord = new DDFRecord(*this);
+    }
+
+    return currentRecord->Read(recordFilter) ? currentRecord : nullptr;
+}
+
+const DDFRecord *DDFModule::ReadRecord(const size_t &recordIdx) noexcept {
+    if (!fileData || openMode == DDF_OM_STREAMED) {
+        return nullptr;
+    }
+
+    if (recordIdx >= recordIndex.size()) {
+        BuildIndex();
+
+        if (recordIdx >= recordIndex.size()) {
+            return nullptr;
+        }
+    }
+
+    fileOffset = recordIndex[recordIdx].recordOffset;
+
+    if (currentRecord) {
+        currentRecord->Clear();
+    }
+
+    return ReadRecord();
+}
             
 void DDFModule::Rewind() noexcept {
-    DDFfileBuf.seekg(firstRecordOffset, ios::beg);
+    if (currentRecord) {
+        currentRecord->Clear();
+    }
+
+    if (openMode != DDF_OM_STREAMED) {
+        fileOffset = firstRecordOffset;
+
+        return;
+    }
+
+    if (!inputStream) {
+        return;
+    }
+
+    inputStream->clear();
+
+    if (streamOrigin == streampos(-1) || !inputStream->seekg(streamOrigin + static_cast<streamoff>(firstRecordOffset))) {
+        if (DDFDiagnostics::Report(DDF_DC_FILE)) {
+            DDFDiagnostics::Post(DDF_DC_FILE, "Unable to rewind a non seekable DDF stream.");
+        }
+
+        return;
+    }
+
+    fileSize = fileOffset = 0ul;
 }
 
 const DDFFieldDefining *DDFModule::FindFieldDefining(const string &fieldName) const noexcept {
-    auto &&field = fieldDefinings.find(fieldName);
-    
-    if (field != fieldDefinings.end())
-        return field->second;
+    if (!descriptiveRecord) {
+        return nullptr;
+    }
+
+    return descriptiveRecord->FindFieldDefining(fieldName);
+}
+
+const DDFFieldDefining *DDFModule::FindFieldDefining(const DDFTag &fieldTag) const noexcept {
+    if (!descriptiveRecord) {
+        return nullptr;
+    }
+
+    return descriptiveRecord->FindFieldDefining(fieldTag);
+}
+
+const shared_ptr<const DDFDescriptiveRecord> DDFModule::FindDescriptiveRecord(const byte *recordData, const size_t &recordLenght, const size_t &recordHash) noexcept {
+    auto &&descriptiveCache = DDFGetDescriptiveCache();
+    lock_guard<mutex> cacheLock(descriptiveCache.cacheMutex);
+
+    for (auto &&cachedRecord : descriptiveCache.descriptiveRecords) {
+        if (cachedRecord->recordHash == recordHash && cachedRecord->recordData.size() == recordLenght && !memcmp(cachedRecord->recordData.data(), recordData, recordLenght)) {
+            return cachedRecord;
+        }
+    }
+
+    return nullptr;
+}
+
+const shared_ptr<const DDFDescriptiveRecord> DDFModule::CacheDescriptiveRecord(const shared_ptr<const DDFDescriptiveRecord> &newRecord) noexcept {
+    auto &&descriptiveCache = DDFGetDescriptiveCache();
+    lock_guard<mutex> cacheLock(descriptiveCache.cacheMutex);
+
+    auto &&descriptiveRecords = descriptiveCache.descriptiveRecords;
+    for (auto &&cachedRecord : descriptiveRecords) {
+        // Another module has read the same DDR meanwhile.
+        if (cachedRecord->recordHash == newRecord->recordHash && cachedRecord->recordData == newRecord->recordData) {
+            return cachedRecord;
+        }
+    }
+
+    if (descriptiveRecords.size() >= DDF_DDR_CACHE_SIZE) {
+        descriptiveRecords.erase(remove_if(descriptiveRecords.begin(), descriptiveRecords.end(), [](const shared_ptr<const DDFDescriptiveRecord> &cachedRecord) {
+            return cachedRecord.use_count() == 1;
+        }), descriptiveRecords.end());
+    }
+
+    if (descriptiveRecords.size() < DDF_DDR_CACHE_SIZE) {
+        descriptiveRecords.push_back(newRecord);
+    }
+
+    return newRecord;
+}
+
+void DDFModule::ClearDescriptiveCache() noexcept {
+    auto &&descriptiveCache = DDFGetDescriptiveCache();
+    lock_guard<mutex> cacheLock(descriptiveCache.cacheMutex);
+
+    descriptiveCache.descriptiveRecords.clear();
+}
+
+const DDFFieldDefining *DDFDescriptiveRecord::FindFieldDefining(const string &fieldName) const noexcept {
+    const auto fieldTag = DDFPackTag(fieldName.data(), fieldName.size());
+
+    if (fieldTag) {
+        return FindFieldDefining(fieldTag);
+    }
+
+    for (auto &&fieldDefining : fieldDefinings) {
+        if (!fieldDefining->GetTag() && fieldDefining->GetName() == fieldName) {
+            return fieldDefining;
+        }
+    }
 
     return nullptr;
 }
 
+const DDFFieldDefining *DDFDescriptiveRecord::FindFieldDefining(const DDFTag &fieldTag) const noexcept {
+    if (!fieldTag || tagTable.empty()) {
+        return nullptr;
+    }
+
+    const auto &&tableMask = tagTable.size() - 1;
+    for (auto idx = static_cast<size_t>((fieldTag * 0x9E3779B1u) >> tagTableShift); ; idx = (idx + 1) & tableMask) {
+        auto &&slot = tagTable[idx];
+
+        if (slot.fieldTag == fieldTag) {
+            return slot.fieldDefining;
+        }
+
+        if (!slot.fieldTag) {
+            return nullptr;
+        }
+    }
+}
+
+void DDFDescriptiveRecord::AddFieldDefining(DDFFieldDefining *fieldDefining) noexcept {
+    for (auto &&currentDefining : fieldDefinings) {
+        if (currentDefining->GetName() == fieldDefining->GetName()) {
+            if (DDFDiagnostics::Report(DDF_DC_DEFINITION)) {
+                DDFDiagnostics::Post(DDF_DC_DEFINITION, "Field '" + fieldDefining->GetName() + "' defined more than once, the last definition is used.");
+            }
+
+            delete currentDefining;
+            currentDefining = fieldDefining;
+
+            return;
+        }
+    }
+
+    fieldDefinings.push_back(fieldDefining);
+}
+
+void DDFDescriptiveRecord::BuildTagTable() noexcept {
+    tagTable.clear();
+
+    // At most half full, so a probe always meets an empty slot.
+    size_t tableSize = 8ul;
+    for (tagTableShift = 29u; tableSize < fieldDefinings.size() * 2; tableSize <<= 1) {
+        --tagTableShift;
+    }
+
+    tagTable.resize(tableSize);
+
+    const auto &&tableMask = tableSize - 1;
+    for (auto &&fieldDefining : fieldDefinings) {
+        const auto &&fieldTag = fieldDefining->GetTag();
+
+        if (!fieldTag) {
+            continue;
+        }
+
+        auto idx = static_cast<size_t>((fieldTag * 0x9E3779B1u) >> tagTableShift);
+        while (tagTable[idx].fieldTag) {
+            idx = (idx + 1) & tableMask;
+        }
+
+        tagTable[idx].fieldTag = fieldTag;
+        tagTable[idx].fieldDefining = fieldDefining;
+    }
+}
+
+const DDFSubfieldHandle DDFModule::FindSubfieldHandle(const string &fieldName, const string &subfieldName) const noexcept {
+    auto &&fieldDefining = FindFieldDefining(fieldName);
+
+    if (!fieldDefining) {
+        return DDFSubfieldHandle();
+    }
+
+    return fieldDefining->GetSubfieldHandle(subfieldName);
+}
+
 void DDFModule::Close() noexcept {
-    if (DDFfileBuf.tellp()) {
-        DDFfileBuf.clear();
+    if (currentRecord) {
+        currentRecord->Clear();
     }
 
-    if (fieldDefinings.size()) {
-        for (auto &&field : fieldDefinings) {
-            delete field.second;
-            field.second = nullptr;
+    if (fileData) {
+        if (openMode == DDF_OM_MAPPED) {
+            DDFUnmapFile(fileData, fileSize);
+        } else {
+            delete [] fileData;
         }
 
-        fieldDefinings.clear();
+        fileData = streamBuffer = nullptr;
+        fileSize = fileOffset = firstRecordOffset = streamCapacity = 0ul;
     }
+
+    recordIndex.clear();
+    indexedOffset = 0ul;
+    isIndexComplete = false;
+
+    if (inputStream) {
+        if (isStreamOwner) {
+            delete inputStream;
+        }
+
+        inputStream = nullptr;
+        isStreamOwner = false;
+        streamOrigin = streampos(-1);
+    }
+
+    descriptiveRecord.reset();
+}
+
+DDFDescriptiveRecord::~DDFDescriptiveRecord() noexcept {
+    for (auto &&field : fieldDefinings) {
+        delete field;
+        field = nullptr;
+    }
+
+    fieldDefinings.clear();
 }
 
 DDFModule::~DDFModule() noexcept {
     Close();
+
+    if (currentRecord) {
+        delete currentRecord;
+        currentRecord = nullptr;
+    }
+}
+
+DDFReader::DDFReader(const DDFModule &parentModule) noexcept : parentModule(parentModule), fileOffset(parentModule.firstRecordOffset), currentRecord(parentModule, nullptr, &fileOffset) {
+}
+
+const bool DDFReader::IsReadable() const noexcept {
+    return parentModule.fileData && parentModule.openMode != DDF_OM_STREAMED;
+}
+
+const DDFRecord *DDFReader::ReadRecord() noexcept {
+    if (!IsReadable()) {
+        return nullptr;
+    }
+
+    return currentRecord.Read() ? &currentRecord : nullptr;
+}
+
+const DDFRecord *DDFReader::ReadRecord(const size_t &recordIdx) noexcept {
+    // The index belongs to the module and is only read here, other readers may use it at the same time.
+    if (!IsReadable() || recordIdx >= parentModule.recordIndex.size()) {
+        return nullptr;
+    }
+
+    fileOffset = parentModule.recordIndex[recordIdx].recordOffset;
+    currentRecord.Clear();
+
+    return ReadRecord();
+}
+
+const DDFRecord *DDFReader::ReadRecord(const DDFRecordFilter &recordFilter) noexcept {
+    if (!IsReadable()) {
+        return nullptr;
+    }
+
+    return currentRecord.Read(recordFilter) ? &currentRecord : nullptr;
+}
+
+void DDFReader::Rewind() noexcept {
+    currentRecord.Clear();
+
+    fileOffset = parentModule.firstRecordOffset;
 }
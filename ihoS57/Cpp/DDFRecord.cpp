@@ -9,159 +9,502 @@
 #include "iso8211.h"
 
 #include <cstring>
-#include <iostream>
+#include <algorithm>
 
 using namespace std;
 using namespace Standards;
 
+DDFRecordFilter::DDFRecordFilter(const initializer_list<string> &recordTags, const initializer_list<string> &requiredTags) noexcept : recordTags(), requiredTags() {
+    for (auto &&recordTag : recordTags) {
+        this->recordTags.push_back(DDFPackTag(recordTag.data(), recordTag.size()));
+    }
+
+    for (auto &&requiredTag : requiredTags) {
+        this->requiredTags.push_back(DDFPackTag(requiredTag.data(), requiredTag.size()));
+    }
+}
+
+const bool DDFRecordFilter::IsRecordTag(const DDFTag &fieldTag) const noexcept {
+    return recordTags.empty() || find(recordTags.begin(), recordTags.end(), fieldTag) != recordTags.end();
+}
+
+const bool DDFRecordFilter::Match(const byte *recordData, const size_t &recordLenght) const noexcept {
+    auto strBuffer = reinterpret_cast<const char*>(recordData);
+
+    size_t sizeFieldLenght = 0ul;
+    size_t sizeFieldPosition = 0ul;
+    size_t sizeFieldTag = 0ul;
+
+    if (recordLenght < DDF_LEADER_SIZE || !DDFParseInt(strBuffer + 20, 1, &sizeFieldLenght) || !DDFParseInt(strBuffer + 21, 1, &sizeFieldPosition) ||
+        !DDFParseInt(strBuffer + 23, 1, &sizeFieldTag) || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
+        return true;
+    }
+
+    const auto dataSize = recordLenght - DDF_LEADER_SIZE;
+    const auto directoryData = recordData + DDF_LEADER_SIZE;
+    const auto fieldEntryWidth = sizeFieldLenght + sizeFieldPosition + sizeFieldTag;
+
+    size_t fieldEntryCount = 0ul;
+    for (auto idx = 0ul; idx + fieldEntryWidth < dataSize && directoryData[idx] != DDF_FIELD_TERMINATOR; idx += fieldEntryWidth) {
+        ++fieldEntryCount;
+    }
+
+    if (!recordTags.empty()) {
+        auto fieldEntry = reinterpret_cast<const char*>(directoryData);
+        if (fieldEntryCount > 1 && sizeFieldTag == 4 && !memcmp(fieldEntry, "0001", 4)) {
+            fieldEntry += fieldEntryWidth;
+        }
+
+        if (!fieldEntryCount || !IsRecordTag(DDFPackTag(fieldEntry, sizeFieldTag))) {
+            return false;
+        }
+    }
+
+    for (auto &&requiredTag : requiredTags) {
+        auto idx = 0ul;
+        for (; idx < fieldEntryCount && DDFPackTag(reinterpret_cast<const char*>(directoryData + idx * fieldEntryWidth), sizeFieldTag) != requiredTag; ++idx);
+
+        if (idx == fieldEntryCount) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 const DDFField* DDFRecord::GetField(const ulong &idx) const {
-    if (idx > fields.size()) {
+    if (idx >= fieldCount) {
         return nullptr;
     }
 
-    return fields[idx];
+    if (isLazyDirectory && fieldStates[idx] != DDF_DES_DECODED) {
+        return LoadField(idx);
+    }
+
+    return &fields[idx];
 }
 
 const DDFField *DDFRecord::FindField(const string &fieldName) const {
-    const auto &&fieldsSize = fields.size();
-    
-    for (auto idx = 0ul; idx < fieldsSize; ++idx) {
-        auto currentFieldName = fields[idx]->GetFieldDefining()->GetName();
+    const auto fieldTag = DDFPackTag(fieldName.data(), fieldName.size());
+
+    if (isLazyDirectory) {
+        for (auto idx = 0ul; idx < fieldCount; ++idx) {
+            if (MatchDirectoryTag(idx, fieldTag, fieldName)) {
+                return GetField(idx);
+            }
+        }
+
+        return nullptr;
+    }
+
+    for (auto idx = 0ul; idx < fieldCount; ++idx) {
+        auto &&fieldDefining = fields[idx].GetFieldDefining();
+
+        if (fieldTag ? fieldDefining->GetTag() == fieldTag : fieldDefining->GetName() == fieldName) {
+            return &fields[idx];
+        }
+    }
+
+    return nullptr;
+}
+
+const DDFField *DDFRecord::FindField(const DDFFieldDefining *fieldDefining) const noexcept {
+    if (isLazyDirectory) {
+        if (!fieldDefining) {
+            return nullptr;
+        }
+
+        for (auto idx = 0ul; idx < fieldCount; ++idx) {
+            if (MatchDirectoryTag(idx, fieldDefining->GetTag(), fieldDefining->GetName())) {
+                auto &&field = GetField(idx);
+
+                if (field && field->GetFieldDefining() == fieldDefining) {
+                    return field;
+                }
+            }
+        }
 
-        if (fieldName == currentFieldName) {
-            return fields[idx];
+        return nullptr;
+    }
+
+    for (auto idx = 0ul; idx < fieldCount; ++idx) {
+        if (fields[idx].GetFieldDefining() == fieldDefining) {
+            return &fields[idx];
         }
     }
 
     return nullptr;
 }
 
+const DDFField *DDFRecord::LoadField(const size_t &idx) const noexcept {
+    if (fieldStates[idx] == DDF_DES_CORRUPT) {
+        return nullptr;
+    }
+
+    size_t fieldLenght = 0ul;
+    size_t fieldOffset = 0ul;
+
+    auto fieldDefinition = ReadDirectoryEntry(idx, &fieldLenght, &fieldOffset);
+
+    if (!fieldDefinition) {
+        fieldStates[idx] = DDF_DES_CORRUPT;
+
+        return nullptr;
+    }
+
+    fields[idx].Initialize(fieldDefinition, fieldLenght, binaryData + fieldOffset);
+    fieldStates[idx] = DDF_DES_DECODED;
+
+    return &fields[idx];
+}
+
+const bool DDFRecord::MatchDirectoryTag(const size_t &idx, const DDFTag &fieldTag, const string &fieldName) const noexcept {
+    auto tagName = reinterpret_cast<const char*>(binaryData + idx * fieldEntryWidth);
+
+    if (fieldTag) {
+        return DDFPackTag(tagName, sizeFieldTag) == fieldTag;
+    }
+
+    return fieldName.size() == sizeFieldTag && !fieldName.compare(0ul, sizeFieldTag, tagName, sizeFieldTag);
+}
+
+const DDFFieldDefining *DDFRecord::ReadDirectoryEntry(const size_t &idx, size_t *fieldLenght, size_t *fieldOffset) const noexcept {
+    auto entryData = reinterpret_cast<const char*>(binaryData + idx * fieldEntryWidth);
+    size_t fieldPosition = 0ul;
+
+    if (!DDFParseInt(entryData + sizeFieldTag, static_cast<byte>(sizeFieldLenght), fieldLenght) ||
+        !DDFParseInt(entryData + sizeFieldTag + sizeFieldLenght, static_cast<byte>(sizeFieldPosition), &fieldPosition)) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record directory appears to be corrupt on DDF file.");
+        }
+
+        return nullptr;
+    }
+
+    const auto fieldTag = DDFPackTag(entryData, sizeFieldTag);
+    auto fieldDefinition = fieldTag ? parentModule.FindFieldDefining(fieldTag) : parentModule.FindFieldDefining(string(entryData, sizeFieldTag));
+
+    if (!fieldDefinition) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Undefined field '" + string(entryData, sizeFieldTag) + "' encoutered in data record");
+        }
+
+        return nullptr;
+    }
+
+    // The offset is measured from the end of the leader, so is the record data.
+    *fieldOffset = fieldAreaStart + fieldPosition - DDF_LEADER_SIZE;
+    if (*fieldOffset > dataSize) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Not enough byte to initialize field '" + fieldDefinition->GetName() + "'.");
+        }
+
+        return nullptr;
+    }
+
+    // The record data points into the file, a field never reaches past the end of it's record.
+    if ((dataSize - *fieldOffset) < *fieldLenght) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Field '" + fieldDefinition->GetName() + "' runs past the end of the data record, it is truncated.");
+        }
+
+        *fieldLenght = dataSize - *fieldOffset;
+    }
+
+    return fieldDefinition;
+}
+
 bool DDFRecord::Read() {
     if (!isReuseHeader) {
         return ReadHeader();
     }
 
-    return false;
+    return ReadFieldArea();
+}
+
+bool DDFRecord::Read(const DDFRecordIndexEntry &recordEntry) noexcept {
+    Clear();
+
+    if (!parentModule.fileData || parentModule.openMode == DDF_OM_STREAMED || recordEntry.recordOffset >= parentModule.fileSize || recordEntry.recordLenght > parentModule.fileSize - recordEntry.recordOffset) {
+        return false;
+    }
+
+    return ParseHeader(parentModule.fileData + recordEntry.recordOffset, recordEntry.recordLenght);
+}
+
+bool DDFRecord::Read(const DDFRecordFilter &recordFilter) noexcept {
+    while (true) {
+        if (isReuseHeader) {
+            if (!ReadFieldArea()) {
+                return false;
+            }
+
+            if (isReuseSelected) {
+                return true;
+            }
+
+            continue;
+        }
+
+        const byte *recordData = nullptr;
+        size_t recordLenght = 0ul;
+
+        if (!LoadRecord(&recordData, &recordLenght)) {
+            return false;
+        }
+
+        const auto isSelected = recordFilter.Match(recordData, recordLenght);
+
+        // A record whose leader and directory are reused is parsed anyway, the following records need it's layout.
+        if (!isSelected && recordData[6] != 'R') {
+            continue;
+        }
+
+        if (!ParseHeader(recordData, recordLenght)) {
+            return false;
+        }
+
+        isReuseSelected = isSelected;
+
+        if (isSelected) {
+            return true;
+        }
+    }
 }
 
 bool DDFRecord::ReadHeader() {
+    const byte *recordData = nullptr;
+    size_t recordLenght = 0ul;
+
+    if (!LoadRecord(&recordData, &recordLenght)) {
+        return false;
+    }
+
+    isReuseSelected = true;
+
+    return ParseHeader(recordData, recordLenght);
+}
+
+bool DDFRecord::LoadRecord(const byte **recordData, size_t *recordLenght) {
     Clear();
 
-    if (parentModule.DDFfileBuf.peek() == EOF) {
-        parentModule.DDFfileBuf.clear();
+    auto bytesLeft = LoadData(DDF_LEADER_SIZE);
 
+    if (!bytesLeft) {
         return false;
     }
 
-    char strBuffer[DDF_LEADER_SIZE];
+    if (bytesLeft < DDF_LEADER_SIZE) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "DR leader is short on DDF file.");
+        }
+
+        *readOffset = parentModule.fileSize;
 
-    //auto pos = parentModule.fileDDF.tellg();
-    if (!parentModule.DDFfileBuf.read(strBuffer, DDF_LEADER_SIZE)) {
-        cout << "WARNING: DR leader is short on DDF file." << endl;
         return false;
     }
 
-    isReuseHeader = strBuffer[6] == 'R';
+    if (!DDFParseInt(reinterpret_cast<const char*>(parentModule.fileData + *readOffset), 5, recordLenght) || *recordLenght < DDF_LEADER_SIZE) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record appears to be corrupt on DDF file, ensure that the files were uncompressed without modifying carriage return/linefeeds (by default WINZIP does this).");
+        }
 
-    auto recordLenght = DDFScanInt(strBuffer, 5);
-    auto fieldAreaStart = DDFScanInt(strBuffer + 12, 5);
+        *readOffset = parentModule.fileSize;
 
-    auto sizeFieldLenght = DDFScanInt(strBuffer + 20, 1);
-    auto sizeFieldPosition = DDFScanInt(strBuffer + 21, 1);
-    auto sizeFieldTag = DDFScanInt(strBuffer + 23, 1);
+        return false;
+    }
 
-    if (recordLenght < DDF_LEADER_SIZE || fieldAreaStart < DDF_LEADER_SIZE || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
-        cout << "WARNING: Data record appears to be corrupt on DDF file." << endl << "-- ensure that the files were uncompressed without modifying carriage return/linefeeds (by default WINZIP does this)." << endl;
+    bytesLeft = LoadData(*recordLenght);
+
+    if (bytesLeft < *recordLenght) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record is short on DDF file.");
+        }
+
+        *readOffset = parentModule.fileSize;
 
         return false;
     }
 
-    dataSize = recordLenght - DDF_LEADER_SIZE;
-    binaryData = new byte[dataSize + 1]();
+    // Only the module's own read position fills the record index, a reader leaves the module untouched.
+    if (cursorModule && parentModule.openMode != DDF_OM_STREAMED && !parentModule.isIndexComplete && *readOffset == parentModule.indexedOffset) {
+        cursorModule->IndexRecord(*readOffset);
+    }
+
+    *recordData = parentModule.fileData + *readOffset;
+    *readOffset += *recordLenght;
+
+    return true;
+}
+
+const size_t DDFRecord::LoadData(const size_t &byteCount) const noexcept {
+    if (cursorModule) {
+        return cursorModule->LoadData(byteCount);
+    }
+
+    return *readOffset < parentModule.fileSize ? parentModule.fileSize - *readOffset : 0ul;
+}
+
+bool DDFRecord::ReadFieldArea() {
+    const auto bytesLeft = LoadData(fieldAreaSize);
 
-    if (!parentModule.DDFfileBuf.read(reinterpret_cast<char*>(binaryData), dataSize)) {
-        cout << "WARNING: Data record is short on DDF file." << endl;
+    if (!bytesLeft) {
+        Clear();
 
         return false;
     }
 
-    auto tagName = new char[sizeFieldTag + 1]();
-    const long fieldEntryWidth = sizeFieldLenght + sizeFieldPosition + sizeFieldTag;
-    for (auto idx = 0ul; idx < dataSize && binaryData[idx] != DDF_FIELD_TERMINATOR; idx += fieldEntryWidth) {
-        auto entryOffset = idx;
+    if (bytesLeft < fieldAreaSize) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record is short on DDF file.");
+        }
 
-        memcpy(tagName, binaryData + entryOffset, sizeFieldTag);
+        *readOffset = parentModule.fileSize;
+        Clear();
 
-        entryOffset += sizeFieldTag;
-        auto fieldLenght = DDFScanInt(reinterpret_cast<char*>(binaryData + entryOffset), sizeFieldLenght);
+        return false;
+    }
 
-        entryOffset += sizeFieldLenght;
-        auto fieldPosition = DDFScanInt(reinterpret_cast<char*>(binaryData + entryOffset), sizeFieldPosition);
+    dataSize = fieldAreaSize;
+    binaryData = parentModule.fileData + *readOffset;
+    *readOffset += fieldAreaSize;
 
-        auto fieldDefinition = parentModule[tagName];
+    // Same layout as the record the leader and directory come from, only the data moves.
+    for (auto idx = 0ul; idx < fieldCount; ++idx) {
+        auto &&field = fields[idx];
+        const auto fieldOffset = min(fieldOffsets[idx], fieldAreaSize);
 
-        if (!fieldDefinition) {
-            cout << "WARNING: Undefined field '" << tagName << "' encoutered in data record" << endl;
+        field.Initialize(field.GetFieldDefining(), min(static_cast<size_t>(field.GetDataSize()), fieldAreaSize - fieldOffset), binaryData + fieldOffset);
+    }
+
+    return true;
+}
 
-            delete [] tagName;
-            tagName = nullptr;
+bool DDFRecord::ParseHeader(const byte *recordData, const size_t &recordLenght) {
+    auto strBuffer = reinterpret_cast<const char*>(recordData);
 
-            return false;
+    isReuseHeader = strBuffer[6] == 'R';
+
+    if (recordLenght < DDF_LEADER_SIZE || !DDFParseInt(strBuffer + 12, 5, &fieldAreaStart) || !DDFParseInt(strBuffer + 20, 1, &sizeFieldLenght) ||
+        !DDFParseInt(strBuffer + 21, 1, &sizeFieldPosition) || !DDFParseInt(strBuffer + 23, 1, &sizeFieldTag) ||
+        fieldAreaStart < DDF_LEADER_SIZE || !sizeFieldLenght || !sizeFieldPosition || !sizeFieldTag) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record appears to be corrupt on DDF file, ensure that the files were uncompressed without modifying carriage return/linefeeds (by default WINZIP does this).");
         }
 
-        const auto fieldOffset = fieldAreaStart + fieldPosition - DDF_LEADER_SIZE;
-        if ((recordLenght - fieldOffset) < fieldLenght) {
-            cout << "WARNING: Not enough byte to initialize field '" << tagName << "'." << endl;
+        return false;
+    }
+
+    dataSize = recordLenght - DDF_LEADER_SIZE;
+    binaryData = recordData + DDF_LEADER_SIZE;
+
+    fieldEntryWidth = sizeFieldLenght + sizeFieldPosition + sizeFieldTag;
+    for (auto idx = 0ul; idx + fieldEntryWidth < dataSize && binaryData[idx] != DDF_FIELD_TERMINATOR; idx += fieldEntryWidth) {
+        ++fieldCount;
+    }
+
+    // The following records have no directory of their own, so a reused one is decoded at once.
+    isLazyDirectory = parentModule.isLazyDirectory && !isReuseHeader;
+
+    if (fields.size() < fieldCount) {
+        fields.resize(fieldCount, DDFField(nullptr, 0ul, nullptr));
+    }
+
+    if (isLazyDirectory) {
+        fieldStates.assign(fieldCount, DDF_DES_PENDING);
 
-            delete [] tagName;
-            tagName = nullptr;
+        return true;
+    }
+
+    if (isReuseHeader) {
+        fieldOffsets.resize(fieldCount);
+    }
+
+    for (auto idx = 0ul; idx < fieldCount; ++idx) {
+        size_t fieldLenght = 0ul;
+        size_t fieldOffset = 0ul;
+
+        auto fieldDefinition = ReadDirectoryEntry(idx, &fieldLenght, &fieldOffset);
+
+        if (!fieldDefinition) {
+            fieldCount = idx;
 
             return false;
         }
 
-        fields.push_back(new DDFField(fieldDefinition, fieldLenght, binaryData + fieldOffset));
+        fields[idx].Initialize(fieldDefinition, fieldLenght, binaryData + fieldOffset);
+
+        if (isReuseHeader) {
+            fieldOffsets[idx] = fieldOffset + DDF_LEADER_SIZE - fieldAreaStart;
+        }
     }
 
-    delete [] tagName;
-    tagName = nullptr;
+    if (isReuseHeader && fieldAreaStart > recordLenght) {
+        if (DDFDiagnostics::Report(DDF_DC_RECORD)) {
+            DDFDiagnostics::Post(DDF_DC_RECORD, "Data record with a reused leader has no field area, the leader isn't reused.");
+        }
+
+        isReuseHeader = false;
+    } else if (isReuseHeader) {
+        fieldAreaSize = recordLenght - fieldAreaStart;
+    }
 
     return true;
 }
 
 void DDFRecord::Clear() {
-    if (fields.size()) {
-        for (auto &&field : fields) {
-            delete field;
-            field = nullptr;
-        }
-
-        fields.clear();
-    }
+    fieldCount = 0ul;
 
     if (binaryData) {
-        delete [] binaryData;
+        if (isClone) {
+            delete [] binaryData;
+        }
+
         binaryData = nullptr;
         dataSize = 0;
     }
 
     isClone = false;
     isReuseHeader = false;
+    isLazyDirectory = false;
 }
 
 DDFRecord* DDFRecord::Clone() const noexcept {
-    auto cloneRecord = new DDFRecord(parentModule);
+    auto cloneRecord = new DDFRecord(parentModule, cursorModule, readOffset);
 
     cloneRecord->dataSize = dataSize;
     cloneRecord->isClone = true;
 
-    cloneRecord->binaryData = new byte[dataSize + 1]();
-    memcpy(cloneRecord->binaryData, binaryData, dataSize);
+    auto cloneData = new byte[dataSize + 1]();
+    memcpy(cloneData, binaryData, dataSize);
+    cloneRecord->binaryData = cloneData;
+
+    cloneRecord->isLazyDirectory = isLazyDirectory;
+    cloneRecord->fieldAreaStart = fieldAreaStart;
+    cloneRecord->sizeFieldLenght = sizeFieldLenght;
+    cloneRecord->sizeFieldPosition = sizeFieldPosition;
+    cloneRecord->sizeFieldTag = sizeFieldTag;
+    cloneRecord->fieldEntryWidth = fieldEntryWidth;
 
-    for(auto&& field : fields) {
-        auto fieldOffset = field->GetBinaryData() - binaryData;
-        cloneRecord->fields.push_back(new DDFField(field->GetFieldDefining(), field->GetDataSize(), cloneRecord->binaryData + fieldOffset));
+    if (isLazyDirectory) {
+        cloneRecord->fieldStates.assign(fieldStates.begin(), fieldStates.begin() + fieldCount);
     }
 
+    cloneRecord->fields.reserve(fieldCount);
+    for (auto idx = 0ul; idx < fieldCount; ++idx) {
+        auto &&field = fields[idx];
+
+        if (isLazyDirectory && fieldStates[idx] != DDF_DES_DECODED) {
+            cloneRecord->fields.emplace_back(nullptr, 0ul, nullptr);
+            continue;
+        }
+
+        auto fieldOffset = field.GetBinaryData() - binaryData;
+        cloneRecord->fields.emplace_back(field.GetFieldDefining(), field.GetDataSize(), cloneRecord->binaryData + fieldOffset);
+    }
+
+    cloneRecord->fieldCount = fieldCount;
+
     return cloneRecord;
 }
 
@@ -10,11 +10,41 @@
 
 #include <cstring>
 #include <cstdint>
-#include <iostream>
+#include <cstdlib>
 
 using namespace std;
 using namespace Standards;
 
+static const size_t DDFNumberBufferSize = 64u;
+
+/**
+ * Copy a numeric subfield value into a zero terminated buffer for strtol/strtod,
+ * values too long for any number are cut.
+ */
+static void DDFCopyNumber(const DDFStringView &stringView, char (&strBuffer)[DDFNumberBufferSize]) noexcept {
+    const auto strLenght = min(stringView.size, DDFNumberBufferSize - 1u);
+
+    if (strLenght) {
+        memcpy(strBuffer, stringView.data, strLenght);
+    }
+
+    strBuffer[strLenght] = '\0';
+}
+
+const long Standards::DDFTextToLong(const DDFStringView &stringView) noexcept {
+    char strBuffer[DDFNumberBufferSize];
+    DDFCopyNumber(stringView, strBuffer);
+
+    return strtol(strBuffer, nullptr, 10);
+}
+
+const double Standards::DDFTextToDouble(const DDFStringView &stringView) noexcept {
+    char strBuffer[DDFNumberBufferSize];
+    DDFCopyNumber(stringView, strBuffer);
+
+    return strtod(strBuffer, nullptr);
+}
+
 const long DDFSubfieldDefining::ExtractDataAsLong(const byte *sourceData, const size_t& dataSize, size_t* consumedBytes) const noexcept{
     switch (dataFormat) {
         case 'A':
@@ -22,13 +52,15 @@ const long DDFSubfieldDefining::ExtractDataAsLong(const byte *sourceData, const
         case 'R':
         case 'S':
         case 'C':
-            return stol(ExtractDataAsString(sourceData, dataSize, consumedBytes), nullptr, 10);
+            return DDFTextToLong(ExtractDataAsStringView(sourceData, dataSize, consumedBytes));
         case 'B':
             return 0l;
         case 'b': {
             byte binaryData[8];
             if (formatWidth > dataSize || formatWidth >= sizeof(binaryData)) {
-                cout << "WARNING: Attempt to extract int subfield " << label << " with format failed as only " << min(dataSize, sizeof(binaryData)) << " bytes available.  Using zero." << endl;
+                if (DDFDiagnostics::Report(DDF_DC_SUBFIELD)) {
+                    DDFDiagnostics::Post(DDF_DC_SUBFIELD, "Attempt to extract int subfield " + string(label) + " with format failed as only " + to_string(min(dataSize, sizeof(binaryData))) + " bytes available.  Using zero.");
+                }
 
                 return 0l;
             }
@@ -87,13 +119,15 @@ const double DDFSubfieldDefining::ExtractDataAsDouble(const byte *sourceData, co
         case 'R':
         case 'S':
         case 'C':
-            return stod(ExtractDataAsString(sourceData, dataSize, consumedBytes), nullptr);
+            return DDFTextToDouble(ExtractDataAsStringView(sourceData, dataSize, consumedBytes));
         case 'B':
             return 0.0;
         case 'b': {
             byte binaryData[8];
             if (formatWidth > dataSize || formatWidth >= sizeof(binaryData)) {
-                cout << "WARNING: Attempt to extract float subfield " << label << " with format failed as only " << min(dataSize, sizeof(binaryData)) << " bytes available.  Using zero." << endl;
+                if (DDFDiagnostics::Report(DDF_DC_SUBFIELD)) {
+                    DDFDiagnostics::Post(DDF_DC_SUBFIELD, "Attempt to extract float subfield " + string(label) + " with format failed as only " + to_string(min(dataSize, sizeof(binaryData))) + " bytes available.  Using zero.");
+                }
 
                 return 0.0;
             }
@@ -163,12 +197,26 @@ const byte* DDFSubfieldDefining::ExtractDataAsBinary(const byte *sourceData, con
     return destString;
 }
 
+const DDFStringView DDFSubfieldDefining::ExtractDataAsStringView(const byte *sourceData, const size_t& dataSize, size_t* consumedBytes) const noexcept{
+    auto strLenght = GetDataLenght(sourceData, dataSize, consumedBytes);
+
+    return DDFStringView(reinterpret_cast<const char*>(sourceData), strLenght);
+}
+
+const DDFBinaryView DDFSubfieldDefining::ExtractDataAsBinaryView(const byte *sourceData, const size_t& dataSize, size_t* consumedBytes) const noexcept{
+    auto strLenght = GetDataLenght(sourceData, dataSize, consumedBytes);
+
+    return DDFBinaryView(sourceData, strLenght);
+}
+
 const size_t DDFSubfieldDefining::GetDataLenght(const byte *sourceData, const size_t &dataSize, size_t* consumedBytes) const noexcept {
     size_t dataLenght = 0ul;
 
     if (!isVariable) {
         if (formatWidth > dataSize) {
-            cout << "WARNING: Only " << dataSize << " bytes available for subfield " << label << endl;
+            if (DDFDiagnostics::Report(DDF_DC_SUBFIELD)) {
+                DDFDiagnostics::Post(DDF_DC_SUBFIELD, "Only " + to_string(dataSize) + " bytes available for subfield " + string(label));
+            }
 
             dataLenght = dataSize;
         } else {
@@ -182,18 +230,23 @@ const size_t DDFSubfieldDefining::GetDataLenght(const byte *sourceData, const si
         long extraConsumedBytes = 0l;
         bool isAsciiField = !(dataSize > 1 && (sourceData[dataSize - 2] == DDF_UNIT_TERMINATOR || sourceData[dataSize - 2] == DDF_FIELD_TERMINATOR) && !sourceData[dataSize - 1]);
 
-        while (dataLenght < dataSize) {
-            if (isAsciiField && (sourceData[dataLenght] == DDF_UNIT_TERMINATOR || sourceData[dataLenght] == DDF_FIELD_TERMINATOR)) {
-                break;
-            } else if (dataLenght > 0 && (sourceData[dataLenght - 1] == DDF_UNIT_TERMINATOR || sourceData[dataLenght - 1] == DDF_FIELD_TERMINATOR) && !sourceData[dataLenght]) {
-                if ((dataLenght + 1) < dataSize && sourceData[dataLenght + 1] == DDF_FIELD_TERMINATOR) {
-                    ++extraConsumedBytes;
-                }
+        if (isAsciiField) {
+            dataLenght = DDFFindDelimiter(sourceData, dataSize);
+        } else {
+            // Two byte terminators: a terminator followed by a zero byte.
+            while (dataLenght < dataSize) {
+                dataLenght += DDFFindDelimiter(sourceData + dataLenght, dataSize - dataLenght) + 1ul;
 
-                break;
+                if (dataLenght < dataSize && !sourceData[dataLenght]) {
+                    if ((dataLenght + 1) < dataSize && sourceData[dataLenght + 1] == DDF_FIELD_TERMINATOR) {
+                        ++extraConsumedBytes;
+                    }
+
+                    break;
+                }
             }
 
-            ++dataLenght;
+            dataLenght = min(dataLenght, dataSize);
         }
 
         if (consumedBytes) {
@@ -256,7 +309,9 @@ bool DDFSubfieldDefining::ApplyFormat(const char*& stringFormat) noexcept {
             }
             break;
         default:
-            cout << "WARNING: Format type of '" << dataFormat << "' not recognised" << endl;
+            if (DDFDiagnostics::Report(DDF_DC_SUBFIELD)) {
+                DDFDiagnostics::Post(DDF_DC_SUBFIELD, "Format type of '" + string(1ul, static_cast<char>(dataFormat)) + "' not recognised");
+            }
             return false;
     }
 
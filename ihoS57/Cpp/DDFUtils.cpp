@@ -8,6 +8,37 @@
 
 #include "iso8211.h"
 
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DDF_X86_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define DDF_TARGET(isa)
+#else
+#define DDF_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 char* Standards::DDFStringUpper(char *&string) noexcept {
     auto bufp = string;
 
@@ -23,16 +54,92 @@ char* Standards::DDFStringUpper(char *&string) noexcept {
 }
 
 int Standards::DDFScanInt(const char *strSource, byte byteRead) noexcept {
-    static char strBuffer[33];
-
     if (byteRead > 32 || !byteRead) {
         byteRead = 32;
     }
 
-    memcpy(strBuffer, strSource, byteRead);
-    strBuffer[byteRead] = '\0';
+    auto idx = 0u;
+    for (; idx < byteRead && isspace(static_cast<byte>(strSource[idx])); ++idx);
+
+    auto isNegative = false;
+    if (idx < byteRead && (strSource[idx] == '-' || strSource[idx] == '+')) {
+        isNegative = strSource[idx++] == '-';
+    }
+
+    long long value = 0ll;
+    for (; idx < byteRead && isdigit(static_cast<byte>(strSource[idx])) && value <= INT_MAX; ++idx) {
+        value = value * 10ll + (strSource[idx] - '0');
+    }
+
+    value = min(value, static_cast<long long>(INT_MAX));
+
+    return static_cast<int>(isNegative ? -value : value);
+}
+
+const DDFTag Standards::DDFPackTag(const char *tagName, const size_t &tagLenght) noexcept {
+    if (!tagName || !tagLenght || tagLenght > DDF_INDEX_TAG_SIZE) {
+        return 0u;
+    }
+
+    DDFTag fieldTag = 0u;
+    for (auto idx = 0ul; idx < tagLenght; ++idx) {
+        fieldTag |= static_cast<DDFTag>(static_cast<byte>(tagName[idx])) << (idx * 8u);
+    }
+
+    return fieldTag;
+}
+
+const bool Standards::DDFParseInt(const char *strSource, const byte byteRead, size_t *value) noexcept {
+    if (!strSource || !value || !byteRead) {
+        return false;
+    }
+
+    if (byteRead <= 8u) {
+        // Right align the digits in a 64 bit word padded with '0', the first
+        // character in the lowest byte, and convert all eight of them at once.
+        char strBuffer[8] = { '0', '0', '0', '0', '0', '0', '0', '0' };
+        memcpy(strBuffer + 8u - byteRead, strSource, byteRead);
 
-    return stoi(strBuffer, nullptr, 10);
+        uint64_t digits = 0ull;
+        for (auto idx = 0u; idx < 8u; ++idx) {
+            digits |= static_cast<uint64_t>(static_cast<byte>(strBuffer[idx])) << (8u * idx);
+        }
+
+        if (((digits & 0xF0F0F0F0F0F0F0F0ull) | (((digits + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull) {
+            digits -= 0x3030303030303030ull;
+            digits = (digits * 10ull + (digits >> 8)) & 0x00FF00FF00FF00FFull;
+            digits = (digits * 100ull + (digits >> 16)) & 0x0000FFFF0000FFFFull;
+            digits = (digits * 10000ull + (digits >> 32)) & 0x00000000FFFFFFFFull;
+
+            *value = static_cast<size_t>(digits);
+
+            return true;
+        }
+    }
+
+    auto idx = 0u;
+    for (; idx < byteRead && strSource[idx] == ' '; ++idx);
+
+    const auto firstDigit = idx;
+
+    size_t number = 0ul;
+    for (; idx < byteRead && strSource[idx] >= '0' && strSource[idx] <= '9'; ++idx) {
+        number = number * 10ul + static_cast<size_t>(strSource[idx] - '0');
+    }
+
+    if (idx == firstDigit || idx - firstDigit > 19u) {
+        return false;
+    }
+
+    for (; idx < byteRead && strSource[idx] == ' '; ++idx);
+
+    if (idx != byteRead) {
+        return false;
+    }
+
+    *value = number;
+
+    return true;
 }
 
 char* Standards::DDFCloneString(const char *strSource, const size_t &byteClone) noexcept {
@@ -64,8 +171,7 @@ const bool Standards::DDFCorrectString(char *&strSource, size_t byteOffset, size
 }
 
 char* Standards::DDFFetchVariable(const char *strRecord, size_t strLenght, size_t *consumedChar, const char delimCharOne, const char delimCharSecond) noexcept {
-    size_t idx;
-    for (idx = 0ul; idx < strLenght && strRecord[idx] != delimCharOne && strRecord[idx] != delimCharSecond; ++idx);
+    auto idx = DDFFindDelimiter(reinterpret_cast<const byte*>(strRecord), strLenght, static_cast<byte>(delimCharOne), static_cast<byte>(delimCharSecond));
 
     auto resultVariable = new char[idx + 1]();
     memcpy(resultVariable, strRecord, idx);
@@ -80,3 +186,297 @@ char* Standards::DDFFetchVariable(const char *strRecord, size_t strLenght, size_
 
     return resultVariable;
 }
+
+static size_t DDFFindDelimiterScalar(const byte *sourceData, const size_t &dataSize, const byte delimCharOne, const byte delimCharSecond) noexcept {
+    size_t idx = 0ul;
+    for (; idx < dataSize && sourceData[idx] != delimCharOne && sourceData[idx] != delimCharSecond; ++idx);
+
+    return idx;
+}
+
+#ifdef DDF_X86_SIMD
+static inline unsigned DDFFirstBit(unsigned mask) noexcept {
+#ifdef _MSC_VER
+    unsigned long bitIdx = 0ul;
+    _BitScanForward(&bitIdx, mask);
+
+    return static_cast<unsigned>(bitIdx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+DDF_TARGET("sse2") static size_t DDFFindDelimiterSSE2(const byte *sourceData, const size_t &dataSize, const byte delimCharOne, const byte delimCharSecond) noexcept {
+    const auto delimOne = _mm_set1_epi8(static_cast<char>(delimCharOne));
+    const auto delimSecond = _mm_set1_epi8(static_cast<char>(delimCharSecond));
+
+    size_t idx = 0ul;
+    for (; idx + 16ul <= dataSize; idx += 16ul) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceData + idx));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, delimOne), _mm_cmpeq_epi8(block, delimSecond))));
+
+        if (mask) {
+            return idx + DDFFirstBit(mask);
+        }
+    }
+
+    return idx + DDFFindDelimiterScalar(sourceData + idx, dataSize - idx, delimCharOne, delimCharSecond);
+}
+
+DDF_TARGET("avx2") static size_t DDFFindDelimiterAVX2(const byte *sourceData, const size_t &dataSize, const byte delimCharOne, const byte delimCharSecond) noexcept {
+    const auto delimOne = _mm256_set1_epi8(static_cast<char>(delimCharOne));
+    const auto delimSecond = _mm256_set1_epi8(static_cast<char>(delimCharSecond));
+
+    size_t idx = 0ul;
+    for (; idx + 32ul <= dataSize; idx += 32ul) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sourceData + idx));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, delimOne), _mm256_cmpeq_epi8(block, delimSecond))));
+
+        if (mask) {
+            return idx + DDFFirstBit(mask);
+        }
+    }
+
+    return idx + DDFFindDelimiterSSE2(sourceData + idx, dataSize - idx, delimCharOne, delimCharSecond);
+}
+
+static bool DDFHasAVX2() noexcept {
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+
+    if (cpuInfo[0] < 7) {
+        return false;
+    }
+
+    __cpuid(cpuInfo, 1);
+
+    // The OS has to save the YMM registers too (OSXSAVE and AVX, then XCR0).
+    if ((cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(cpuInfo, 7, 0);
+
+    return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static bool DDFHasSSE2() noexcept {
+#if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+
+    return (cpuInfo[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+#endif
+
+typedef size_t (*DDFFindDelimiterKernel)(const byte*, const size_t&, const byte, const byte);
+
+static DDFFindDelimiterKernel DDFSelectFindDelimiter() noexcept {
+#ifdef DDF_X86_SIMD
+    if (DDFHasAVX2()) {
+        return DDFFindDelimiterAVX2;
+    }
+
+    if (DDFHasSSE2()) {
+        return DDFFindDelimiterSSE2;
+    }
+#endif
+
+    return DDFFindDelimiterScalar;
+}
+
+size_t Standards::DDFFindDelimiter(const byte *sourceData, const size_t &dataSize, const byte delimCharOne, const byte delimCharSecond) noexcept {
+    static const auto findDelimiter = DDFSelectFindDelimiter();
+
+    return findDelimiter(sourceData, dataSize, delimCharOne, delimCharSecond);
+}
+
+const byte* Standards::DDFMapFile(const string &fileName, size_t *fileSize) noexcept {
+    if (!fileSize) {
+        return nullptr;
+    }
+
+    *fileSize = 0ul;
+    const byte* fileData = nullptr;
+
+#ifdef _WIN32
+    auto fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileLenght;
+    if (GetFileSizeEx(fileHandle, &fileLenght) && fileLenght.QuadPart > 0) {
+        auto mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mappingHandle) {
+            fileData = static_cast<const byte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mappingHandle);
+        }
+
+        if (fileData) {
+            *fileSize = static_cast<size_t>(fileLenght.QuadPart);
+        }
+    }
+
+    CloseHandle(fileHandle);
+#else
+    auto fileHandle = open(fileName.c_str(), O_RDONLY);
+
+    if (fileHandle < 0) {
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (!fstat(fileHandle, &fileStat) && fileStat.st_size > 0) {
+        auto mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileHandle, 0);
+
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+            fileData = static_cast<const byte*>(mapping);
+            *fileSize = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+
+    close(fileHandle);
+#endif
+
+    return fileData;
+}
+
+void Standards::DDFUnmapFile(const byte *fileData, const size_t &fileSize) noexcept {
+    if (!fileData) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(fileData);
+#else
+    munmap(const_cast<byte*>(fileData), fileSize);
+#endif
+}
+
+/**
+ * State of DDFDiagnostics.  The counters and the rate limit are lock free, only a
+ * message let through by the limit takes the lock of the ring.
+ */
+struct DDFDiagnosticSink {
+    atomic<size_t> categoryCounts[Standards::DDF_DC_COUNT];
+    atomic<size_t> droppedCount;
+
+    atomic<size_t> messageRate;
+    atomic<long long> rateSecond;
+    atomic<size_t> rateCount;
+
+    mutex ringMutex;
+    vector<Standards::DDFDiagnostic> messageRing;
+    size_t ringBegin = 0ul;
+    size_t ringSize = 0ul;
+};
+
+static DDFDiagnosticSink &DDFGetDiagnosticSink() noexcept {
+    static DDFDiagnosticSink diagnosticSink;
+
+    return diagnosticSink;
+}
+
+const bool Standards::DDFDiagnostics::Report(const Standards::DDFdiagnosticCategory category) noexcept {
+    auto &&sink = DDFGetDiagnosticSink();
+
+    sink.categoryCounts[category].fetch_add(1ul, memory_order_relaxed);
+
+    const auto messageRate = sink.messageRate.load(memory_order_relaxed);
+    if (!messageRate) {
+        return false;
+    }
+
+    const long long currentSecond = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    auto rateSecond = sink.rateSecond.load(memory_order_relaxed);
+
+    // The first report of a new second restarts the count, the others race for the rest of the budget.
+    if (rateSecond != currentSecond && sink.rateSecond.compare_exchange_strong(rateSecond, currentSecond, memory_order_relaxed)) {
+        sink.rateCount.store(0ul, memory_order_relaxed);
+    }
+
+    if (sink.rateCount.fetch_add(1ul, memory_order_relaxed) >= messageRate) {
+        sink.droppedCount.fetch_add(1ul, memory_order_relaxed);
+
+        return false;
+    }
+
+    return true;
+}
+
+void Standards::DDFDiagnostics::Post(const Standards::DDFdiagnosticCategory category, const string &message) noexcept {
+    auto &&sink = DDFGetDiagnosticSink();
+    lock_guard<mutex> ringLock(sink.ringMutex);
+
+    if (sink.messageRing.size() < DDF_DIAGNOSTIC_RING_SIZE) {
+        sink.messageRing.resize(DDF_DIAGNOSTIC_RING_SIZE);
+    }
+
+    if (sink.ringSize == DDF_DIAGNOSTIC_RING_SIZE) {
+        sink.ringBegin = (sink.ringBegin + 1ul) % DDF_DIAGNOSTIC_RING_SIZE;
+        --sink.ringSize;
+
+        sink.droppedCount.fetch_add(1ul, memory_order_relaxed);
+    }
+
+    auto &&diagnostic = sink.messageRing[(sink.ringBegin + sink.ringSize) % DDF_DIAGNOSTIC_RING_SIZE];
+    diagnostic.category = category;
+    diagnostic.message = message;
+
+    ++sink.ringSize;
+}
+
+const size_t Standards::DDFDiagnostics::Drain(vector<Standards::DDFDiagnostic> &messages) noexcept {
+    auto &&sink = DDFGetDiagnosticSink();
+    lock_guard<mutex> ringLock(sink.ringMutex);
+
+    const auto messageCount = sink.ringSize;
+    for (auto idx = 0ul; idx < messageCount; ++idx) {
+        messages.push_back(move(sink.messageRing[(sink.ringBegin + idx) % DDF_DIAGNOSTIC_RING_SIZE]));
+    }
+
+    sink.ringBegin = sink.ringSize = 0ul;
+
+    return messageCount;
+}
+
+const size_t Standards::DDFDiagnostics::GetCount(const Standards::DDFdiagnosticCategory category) noexcept {
+    return category < DDF_DC_COUNT ? DDFGetDiagnosticSink().categoryCounts[category].load(memory_order_relaxed) : 0ul;
+}
+
+const size_t Standards::DDFDiagnostics::GetDroppedCount() noexcept {
+    return DDFGetDiagnosticSink().droppedCount.load(memory_order_relaxed);
+}
+
+void Standards::DDFDiagnostics::SetMessageRate(const size_t messageRate) noexcept {
+    DDFGetDiagnosticSink().messageRate.store(messageRate, memory_order_relaxed);
+}
+
+void Standards::DDFDiagnostics::Reset() noexcept {
+    auto &&sink = DDFGetDiagnosticSink();
+
+    for (auto &&categoryCount : sink.categoryCounts) {
+        categoryCount.store(0ul, memory_order_relaxed);
+    }
+
+    sink.droppedCount.store(0ul, memory_order_relaxed);
+
+    lock_guard<mutex> ringLock(sink.ringMutex);
+    sink.ringBegin = sink.ringSize = 0ul;
+}
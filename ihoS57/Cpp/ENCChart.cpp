@@ -9,27 +9,184 @@
 
 #include "ihoS57.h"
 
+#include <thread>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <system_error>
 
 using namespace std;
 using namespace Standards;
 
-const bool ENCChart::Open() noexcept{
+const bool ENCingestProfile::IsFieldSelected(const string &fieldName) const noexcept {
+    return fields.empty() || fields.find(fieldName) != fields.end();
+}
+
+const bool ENCingestProfile::IsSubfieldSelected(const string &fieldName, const string &subfieldName) const noexcept {
+    if (fields.empty()) {
+        return true;
+    }
+
+    auto &&foundField = fields.find(fieldName);
+    if (foundField == fields.end()) {
+        return false;
+    }
+
+    auto &&subfieldNames = foundField->second;
+
+    return subfieldNames.empty() || find(subfieldNames.begin(), subfieldNames.end(), subfieldName) != subfieldNames.end();
+}
+
+const bool ENCingestProfile::IsAttributeSelected(const uint &attributeCode) const noexcept {
+    return attributeCodes.empty() || find(attributeCodes.begin(), attributeCodes.end(), attributeCode) != attributeCodes.end();
+}
+
+void ENCsubfieldHandles::Resolve(const DDFModule &module, const ENCingestProfile &profile) noexcept {
+    *this = ENCsubfieldHandles();
+
+    DSID.field = module.FindFieldDefining("DSID");
+    DSID.DSNM = module.FindSubfieldHandle("DSID", "DSNM");
+
+    DSSI.NALL = module.FindSubfieldHandle("DSSI", "NALL");
+    DSSI.AALL = module.FindSubfieldHandle("DSSI", "AALL");
+    DSSI.DSTR = module.FindSubfieldHandle("DSSI", "DSTR");
+
+    DSPM.field = module.FindFieldDefining("DSPM");
+    DSPM.COMF = module.FindSubfieldHandle("DSPM", "COMF");
+    DSPM.SOMF = module.FindSubfieldHandle("DSPM", "SOMF");
+    DSPM.CSCL = module.FindSubfieldHandle("DSPM", "CSCL");
+
+    // The record identifiers are always read, all of their subfields unless the profile lists the field.
+    const auto &&isWholeVRID = !profile.fields.count("VRID");
+    const auto &&isWholeFRID = !profile.fields.count("FRID");
+
+    auto &&findHandle = [&module, &profile](const string &fieldName, const string &subfieldName, const bool isWholeField) {
+        return isWholeField || profile.IsSubfieldSelected(fieldName, subfieldName) ? module.FindSubfieldHandle(fieldName, subfieldName) : DDFSubfieldHandle();
+    };
+
+    auto &&findField = [&module, &profile](const string &fieldName) -> const DDFFieldDefining* {
+        return profile.IsFieldSelected(fieldName) ? module.FindFieldDefining(fieldName) : nullptr;
+    };
+
+    VRID.field = module.FindFieldDefining("VRID");
+    VRID.RCNM = module.FindSubfieldHandle("VRID", "RCNM");
+    VRID.RCID = module.FindSubfieldHandle("VRID", "RCID");
+    VRID.RVER = findHandle("VRID", "RVER", isWholeVRID);
+    VRID.RUIN = findHandle("VRID", "RUIN", isWholeVRID);
+
+    VRPT.field = findField("VRPT");
+    VRPT.NAME = findHandle("VRPT", "NAME", false);
+    VRPT.ORNT = findHandle("VRPT", "ORNT", false);
+    VRPT.USAG = findHandle("VRPT", "USAG", false);
+    VRPT.MASK = findHandle("VRPT", "MASK", false);
+    VRPT.TOPI = findHandle("VRPT", "TOPI", false);
+
+    SG2D.field = findField("SG2D");
+    SG2D.XCOO = findHandle("SG2D", "XCOO", false);
+    SG2D.YCOO = findHandle("SG2D", "YCOO", false);
+
+    SG3D.field = findField("SG3D");
+    SG3D.XCOO = findHandle("SG3D", "XCOO", false);
+    SG3D.YCOO = findHandle("SG3D", "YCOO", false);
+    SG3D.VE3D = findHandle("SG3D", "VE3D", false);
+
+    FRID.field = module.FindFieldDefining("FRID");
+    FRID.PRIM = findHandle("FRID", "PRIM", isWholeFRID);
+    FRID.RCNM = module.FindSubfieldHandle("FRID", "RCNM");
+    FRID.RCID = module.FindSubfieldHandle("FRID", "RCID");
+    FRID.RVER = findHandle("FRID", "RVER", isWholeFRID);
+    FRID.RUIN = findHandle("FRID", "RUIN", isWholeFRID);
+    FRID.GRUP = findHandle("FRID", "GRUP", isWholeFRID);
+    FRID.OBJL = findHandle("FRID", "OBJL", isWholeFRID);
+
+    FOID.field = findField("FOID");
+    FOID.AGEN = findHandle("FOID", "AGEN", false);
+    FOID.FIDN = findHandle("FOID", "FIDN", false);
+    FOID.FIDS = findHandle("FOID", "FIDS", false);
+
+    FSPT.field = findField("FSPT");
+    FSPT.NAME = findHandle("FSPT", "NAME", false);
+    FSPT.ORNT = findHandle("FSPT", "ORNT", false);
+    FSPT.USAG = findHandle("FSPT", "USAG", false);
+    FSPT.MASK = findHandle("FSPT", "MASK", false);
+
+    // An attribute is nothing without it's value, the attributes are picked by ATTL instead.
+    ATTF.field = findField("ATTF");
+    ATTF.ATTL = findHandle("ATTF", "ATTL", true);
+    ATTF.ATVL = findHandle("ATTF", "ATVL", true);
+
+    NATF.field = findField("NATF");
+    NATF.ATTL = findHandle("NATF", "ATTL", true);
+    NATF.ATVL = findHandle("NATF", "ATVL", true);
+
+    // The fixed layout decodes every subfield, so a field with some left out goes through the handles.
+    VRID.isLayoutValid = S57Field<ENCfieldVRID>::CheckLayout(VRID.field) && VRID.RVER.IsValid() && VRID.RUIN.IsValid();
+    VRPT.isLayoutValid = S57Field<ENCfieldVRPT>::CheckLayout(VRPT.field) && VRPT.NAME.IsValid() && VRPT.ORNT.IsValid() && VRPT.USAG.IsValid() && VRPT.MASK.IsValid() && VRPT.TOPI.IsValid();
+    SG2D.isLayoutValid = S57Field<ENCfieldSG2D>::CheckLayout(SG2D.field) && SG2D.XCOO.IsValid() && SG2D.YCOO.IsValid();
+    SG3D.isLayoutValid = S57Field<ENCfieldSG3D>::CheckLayout(SG3D.field) && SG3D.XCOO.IsValid() && SG3D.YCOO.IsValid() && SG3D.VE3D.IsValid();
+    FRID.isLayoutValid = S57Field<ENCfieldFRID>::CheckLayout(FRID.field) && FRID.PRIM.IsValid() && FRID.RVER.IsValid() && FRID.RUIN.IsValid() && FRID.GRUP.IsValid() && FRID.OBJL.IsValid();
+    FOID.isLayoutValid = S57Field<ENCfieldFOID>::CheckLayout(FOID.field) && FOID.AGEN.IsValid() && FOID.FIDN.IsValid() && FOID.FIDS.IsValid();
+    FSPT.isLayoutValid = S57Field<ENCfieldFSPT>::CheckLayout(FSPT.field) && FSPT.NAME.IsValid() && FSPT.ORNT.IsValid() && FSPT.USAG.IsValid() && FSPT.MASK.IsValid();
+}
+
+const bool Standards::ENCCheckLayout(const DDFFieldDefining *fieldDefining, const ENCsubfieldLayout *layout, const size_t &layoutSize, const bool isRepeating) noexcept {
+    if (!fieldDefining || fieldDefining->GetSubfieldCount() != layoutSize || fieldDefining->isRepiting() != isRepeating) {
+        return false;
+    }
+
+    size_t fixedWidth = 0ul;
+    for (auto idx = 0ul; idx < layoutSize; ++idx) {
+        auto &&subfield = fieldDefining->GetSubfieldDefining(idx);
+        auto &&subfieldLayout = layout[idx];
+
+        if (subfield->GetName() != subfieldLayout.name || subfield->GetFormat() != subfieldLayout.format || subfield->GetWidth() != subfieldLayout.width ||
+            (subfieldLayout.format == 'b' && subfield->GetBinaryFormat() != subfieldLayout.binaryFormat)) {
+            return false;
+        }
+
+        fixedWidth += subfieldLayout.width;
+    }
+
+    return fieldDefining->GetFixedWidth() == fixedWidth;
+}
+
+const bool ENCChart::Open(const DDFopenMode openMode) noexcept{
     if (module) {
         return true;
     }
 
     module = new DDFModule;
-    if (!module->Open(fileName)) {
+    if (!module->Open(fileName, false, openMode)) {
         delete module;
         module = nullptr;
 
         return false;
     }
 
+    return CheckModule();
+}
+
+const bool ENCChart::Open(istream &inputStream) noexcept{
+    if (module) {
+        return true;
+    }
+
+    module = new DDFModule;
+    if (!module->Open(inputStream)) {
+        delete module;
+        module = nullptr;
+
+        return false;
+    }
+
+    return CheckModule();
+}
+
+const bool ENCChart::CheckModule() noexcept {
     if (!module->FindFieldDefining("DSID")/* && !(isCatalogField = module->FindFieldDefining("CATD"))*/) {
-        cout << "ERROR: '" << fileName << "' is an ISO8211 file, but not an IHO S-57 data file." << endl;
+        if (DDFDiagnostics::Report(DDF_DC_CONTENT)) {
+            DDFDiagnostics::Post(DDF_DC_CONTENT, "'" + fileName + "' is an ISO8211 file, but not an IHO S-57 data file.");
+        }
 
         delete module;
         module = nullptr;
@@ -37,43 +194,256 @@ const bool ENCChart::Open() noexcept{
         return false;
     }
 
+    handles.Resolve(*module, profile);
+
+    // Ingest dispatches on the first data field and then picks a few fields by
+    // definition, the rest of the directory doesn't need to be decoded.
+    module->SetLazyDirectory(true);
+
     return true;
 }
 
-const bool ENCChart::Ingest() noexcept {
+void ENCChart::SetIngestProfile(const ENCingestProfile &ingestProfile) noexcept {
+    profile = ingestProfile;
+
+    if (module) {
+        handles.Resolve(*module, profile);
+    }
+}
+
+void ENCChart::SetCoordinateStorage(const ENCcoordinateStorage coordinateStorage) noexcept {
+    this->coordinateStorage = coordinateStorage;
+}
+
+void ENCChart::ScaleCoordinates() noexcept {
+    vertexPool.Scale();
+    soundingPool.Scale();
+}
+
+void ENCChart::PreparePools() noexcept {
+    vertexPool.isRaw = soundingPool.isRaw = coordinateStorage == ENC_CS_RAW;
+
+    vertexPool.COMF = soundingPool.COMF = COMF;
+    vertexPool.SOMF = soundingPool.SOMF = SOMF;
+}
+
+void Standards::ENCDecodeText(const DDFBinaryView &value, const long &lexicalLevel, string &text) noexcept {
+    text.clear();
+
+    auto &&appendCodePoint = [&text](const uint codePoint) {
+        if (codePoint < 0x80u) {
+            text.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800u) {
+            text.push_back(static_cast<char>(0xC0u | (codePoint >> 6u)));
+            text.push_back(static_cast<char>(0x80u | (codePoint & 0x3Fu)));
+        } else {
+            text.push_back(static_cast<char>(0xE0u | (codePoint >> 12u)));
+            text.push_back(static_cast<char>(0x80u | ((codePoint >> 6u) & 0x3Fu)));
+            text.push_back(static_cast<char>(0x80u | (codePoint & 0x3Fu)));
+        }
+    };
+
+    if (lexicalLevel == ENC_LL_2) {
+        // Little endian code units.  GetDataLenght() counts the 0x1F byte of the 0x1F 0x00
+        // unit terminator, so the view has an odd size and the division by 2 drops that byte.
+        for (auto idx = 0ul; idx < value.size / 2ul; ++idx) {
+            const auto &&codeUnit = ENCReadUInt16(value.data + idx * 2ul);
+            if (!codeUnit) {
+                break;
+            }
+
+            appendCodePoint(codeUnit);
+        }
+
+        return;
+    }
+
+    // ASCII is the lower half of ISO 8859-1, whose code points are the first 256 of UCS.
+    for (auto &&character : value) {
+        if (!character || character == DDF_UNIT_TERMINATOR || character == DDF_FIELD_TERMINATOR) {
+            break;
+        }
+
+        appendCodePoint(character);
+    }
+}
+
+const bool ENCChart::Ingest(const uint threadCount, const ENCingestMode ingestMode) noexcept {
     if (!module || isFileIngested)
         return false;
 
-    const DDFRecord* record = nullptr;
-    while ((record = module->ReadRecord())) {
-        auto&& field = record->GetField(1ull);
-        auto&& fieldDefiningName = field->GetFieldDefining()->GetName();
-
-        if (fieldDefiningName == "DSID") {
-            DSNM = field->GetSubfieldAsString("DSNM");
-
-            auto &&dssi = record->GetField(2ull);
-            NALL = dssi->GetSubfieldAsLong("NALL");
-            AALL = dssi->GetSubfieldAsLong("AALL");
-            DSTR = static_cast<ENCdataStructure>(dssi->GetSubfieldAsLong("DSTR"));
-        } else if (fieldDefiningName == "DSPM") {
-            COMF = max(1l, field->GetSubfieldAsLong("COMF"));
-            SOMF = max(1l, field->GetSubfieldAsLong("SOMF"));
-            CSCL = max(1l, field->GetSubfieldAsLong("CSCL"));
-        } else if (fieldDefiningName == "VRID") {
-            ReadVector(record, field);
-        } else if (fieldDefiningName == "FRID") {
-            ReadFeature(record, field);
-        } else {
-            cout << "INFO: Skipping '" << fieldDefiningName << "' record in ENCChart::Ingest()." << endl;
+    const auto workerCount = threadCount ? threadCount : max(1u, thread::hardware_concurrency());
+
+    PreparePools();
+
+    DDFRecordFilter recordFilter;
+    if (ingestMode == ENC_IM_FEATURES) {
+        recordFilter = DDFRecordFilter({ "DSID", "DSPM", "FRID" });
+    } else if (ingestMode == ENC_IM_GEOMETRY) {
+        recordFilter = DDFRecordFilter({ "DSID", "DSPM", "VRID" });
+    }
+
+    if (workerCount > 1u && module->GetOpenMode() != DDF_OM_STREAMED && module->BuildIndex()) {
+        IngestParallel(workerCount, recordFilter);
+    } else {
+        const DDFRecord* record = nullptr;
+        while ((record = ingestMode == ENC_IM_ALL ? module->ReadRecord() : module->ReadRecord(recordFilter))) {
+            IngestRecord(record);
         }
     }
+
+    IndexAttributes();
     
     isFileIngested = true;
 
     return FindAndUpplyUpdates();
 }
 
+void ENCChart::IngestRecord(const DDFRecord *record) noexcept {
+    auto&& field = record->GetField(1ull);
+    if (!field) {
+        return;
+    }
+
+    auto&& fieldDefining = field->GetFieldDefining();
+
+    if (fieldDefining == handles.DSID.field) {
+        DSNM = field->GetSubfieldAsString(handles.DSID.DSNM);
+
+        auto &&dssi = record->GetField(2ull);
+        if (!dssi) {
+            return;
+        }
+
+        NALL = dssi->GetSubfieldAsLong(handles.DSSI.NALL);
+        AALL = dssi->GetSubfieldAsLong(handles.DSSI.AALL);
+        DSTR = static_cast<ENCdataStructure>(dssi->GetSubfieldAsLong(handles.DSSI.DSTR));
+    } else if (fieldDefining == handles.DSPM.field) {
+        COMF = max(1l, field->GetSubfieldAsLong(handles.DSPM.COMF));
+        SOMF = max(1l, field->GetSubfieldAsLong(handles.DSPM.SOMF));
+        CSCL = max(1l, field->GetSubfieldAsLong(handles.DSPM.CSCL));
+
+        PreparePools();
+    } else if (fieldDefining == handles.VRID.field) {
+        ReadVector(record, field);
+    } else if (fieldDefining == handles.FRID.field) {
+        ReadFeature(record, field);
+    } else {
+        if (DDFDiagnostics::Report(DDF_DC_SKIPPED)) {
+            DDFDiagnostics::Post(DDF_DC_SKIPPED, "Skipping '" + fieldDefining->GetName() + "' record in ENCChart::Ingest().");
+        }
+    }
+}
+
+void ENCChart::IngestParallel(const uint workerCount, const DDFRecordFilter &recordFilter) noexcept {
+    auto &&recordIndex = module->GetRecordIndex();
+    const auto &&recordCount = recordIndex.size();
+
+    // The data set records (DSID, DSPM, ...) set up the factors the spatial and
+    // feature records are decoded with, so they are read first on this thread.
+    vector<size_t> recordIdxs;
+    recordIdxs.reserve(recordCount);
+
+    DDFReader reader(*module);
+    const DDFRecord *record = nullptr;
+
+    for (auto idx = 0ul; idx < recordCount; ++idx) {
+        auto &&recordEntry = recordIndex[idx];
+
+        if (!recordFilter.IsRecordTag(DDFPackTag(recordEntry.fieldTag, DDF_INDEX_TAG_SIZE))) {
+            continue;
+        }
+
+        if (!memcmp(recordEntry.fieldTag, "VRID", DDF_INDEX_TAG_SIZE) || !memcmp(recordEntry.fieldTag, "FRID", DDF_INDEX_TAG_SIZE)) {
+            recordIdxs.push_back(idx);
+        } else if ((record = reader.ReadRecord(idx))) {
+            IngestRecord(record);
+        }
+    }
+
+    // Every worker decodes a contiguous span of the remaining records into a chart of
+    // its own, the spans are merged back in file order so later records still win.
+    const auto spanCount = min(static_cast<size_t>(workerCount), recordIdxs.size());
+
+    vector<ENCChart*> partialCharts;
+    vector<thread> workers;
+
+    for (auto spanIdx = 0ul; spanIdx < spanCount; ++spanIdx) {
+        auto &&partialChart = new ENCChart(fileName);
+        partialChart->DSTR = DSTR;
+        partialChart->NALL = NALL;
+        partialChart->AALL = AALL;
+        partialChart->COMF = COMF;
+        partialChart->SOMF = SOMF;
+        partialChart->CSCL = CSCL;
+        partialChart->handles = handles;
+        partialChart->profile = profile;
+        partialChart->coordinateStorage = coordinateStorage;
+        partialChart->PreparePools();
+
+        partialCharts.push_back(partialChart);
+
+        const auto &&spanBegin = recordIdxs.size() * spanIdx / spanCount;
+        const auto &&spanEnd = recordIdxs.size() * (spanIdx + 1ul) / spanCount;
+
+        auto &&decodeSpan = [this, partialChart, spanBegin, spanEnd, &recordIdxs]() {
+            DDFReader spanReader(*module);
+            const DDFRecord *spanRecord = nullptr;
+
+            for (auto idx = spanBegin; idx < spanEnd; ++idx) {
+                if ((spanRecord = spanReader.ReadRecord(recordIdxs[idx]))) {
+                    partialChart->IngestRecord(spanRecord);
+                }
+            }
+        };
+
+        try {
+            workers.emplace_back(decodeSpan);
+        } catch (const system_error&) {
+            decodeSpan();
+        }
+    }
+
+    for (auto &&worker : workers) {
+        worker.join();
+    }
+
+    for (auto &&partialChart : partialCharts) {
+        // The vertices of a partial chart go after the ones already merged.
+        for (auto &&edge : partialChart->edges) {
+            edge->pointOffset += vertexPool.size();
+        }
+
+        for (auto &&isolatedNode : partialChart->isolatedNodes) {
+            isolatedNode->pointOffset += vertexPool.size();
+            isolatedNode->soundingOffset += soundingPool.size();
+        }
+
+        for (auto &&connectedNode : partialChart->connectedNodes) {
+            connectedNode->pointOffset += vertexPool.size();
+            connectedNode->soundingOffset += soundingPool.size();
+        }
+
+        for (auto &&feature : partialChart->features) {
+            feature->attributeOffset += attributes.size();
+        }
+
+        vertexPool.Append(partialChart->vertexPool);
+        soundingPool.Append(partialChart->soundingPool);
+        attributes.Append(partialChart->attributes);
+
+        edges.Merge(partialChart->edges);
+        features.Merge(partialChart->features);
+        isolatedNodes.Merge(partialChart->isolatedNodes);
+        connectedNodes.Merge(partialChart->connectedNodes);
+
+        boundingRegion.Extend(partialChart->boundingRegion);
+
+        delete partialChart;
+        partialChart = nullptr;
+    }
+}
+
 const bool ENCChart::View() noexcept {
     ulong recordNumber = 0ul;
 
@@ -84,6 +454,10 @@ const bool ENCChart::View() noexcept {
         const auto &&fieldCount = record->GetFieldCount();
         for (auto fieldIdx = 0ul; fieldIdx < fieldCount; ++fieldIdx) {
             auto &&field = record->GetField(fieldIdx);
+            if (!field) {
+                continue;
+            }
+
             auto &&fieldDefining = field->GetFieldDefining();
 
             size_t bytesConsumed = 0ul;
@@ -189,87 +563,104 @@ const bool ENCChart::ApplyUpdates(DDFModule &updModule, byte &updNumber) noexcep
 }
 
 const bool ENCChart::ReadVector(const DDFRecord *&record, const DDFField *&fieldVRID) noexcept {
-    auto &&RCNM = fieldVRID->GetSubfieldAsLong("RCNM");
+    const auto vrid = DecodeField<ENCfieldVRID>(fieldVRID);
+    const auto RCNM = static_cast<ulong>(vrid.RCNM);
 
     if (RCNM < ENC_RCNM_VI || RCNM > ENC_RCNM_VF) {
-        cout << "ERROR: Unrecognised record name code '" << RCNM << "'." << endl << "Field initialization incorrect." << endl;
+        if (DDFDiagnostics::Report(DDF_DC_CONTENT)) {
+            DDFDiagnostics::Post(DDF_DC_CONTENT, "Unrecognised record name code '" + to_string(RCNM) + "', field initialization incorrect.");
+        }
         return false;
     }
 
-    auto &&RCID = fieldVRID->GetSubfieldAsLong("RCID");
-    auto &&RVER = fieldVRID->GetSubfieldAsLong("RVER");
-    auto &&RUIN = fieldVRID->GetSubfieldAsLong("RUIN");
+    const auto RCID = static_cast<ulong>(vrid.RCID);
 
     const DDFField *field = nullptr;
     if (RCNM == ENC_RCNM_VI || RCNM == ENC_RCNM_VC) {
-        auto &&pointFeature = new ENCPointGeometry(RCNM, RCID, RVER, RUIN);
-
-        if ((field = record->FindField("SG2D"))) {
-            pointFeature->point.x = field->GetSubfieldAsLong("XCOO") / COMF;
-            pointFeature->point.y = field->GetSubfieldAsLong("YCOO") / COMF;
-        } else if ((field = record->FindField("SG3D"))){
-            pointFeature->point.x = field->GetSubfieldAsLong("XCOO") / COMF;
-            pointFeature->point.y = field->GetSubfieldAsLong("YCOO") / COMF;
-            pointFeature->point.z = field->GetSubfieldAsLong("VE3D") / SOMF;
+        auto &&pointNodes = RCNM == ENC_RCNM_VI ? isolatedNodes : connectedNodes;
+        auto &&pointFeature = pointNodes.Construct(RCNM, RCID, vrid.RVER, vrid.RUIN);
+
+        if (!handles.SG2D.field && !handles.SG3D.field) {
+            // The coordinates aren't part of the ingest profile.
+        } else if ((field = record->FindField(handles.SG2D.field))) {
+            const auto sg2d = DecodeField<ENCfieldSG2D>(field);
+
+            // In the vertex pool like the edges, so ENC_CS_RAW keeps the integers of the nodes too.
+            pointFeature->pointOffset = vertexPool.size();
+            pointFeature->pointCount = 1ul;
+
+            vertexPool.AddPoint(sg2d.XCOO, sg2d.YCOO);
+            pointFeature->point = vertexPool.GetPoint(pointFeature->pointOffset);
+        } else if ((field = record->FindField(handles.SG3D.field)) && DecodeRepeats(field, soundings)) {
+            pointFeature->soundingOffset = soundingPool.size();
+            pointFeature->soundingCount = soundings.size();
+
+            for (auto &&sounding : soundings) {
+                soundingPool.AddPoint(sounding.XCOO, sounding.YCOO, sounding.VE3D);
+                boundingRegion.Extend(sounding.XCOO / COMF, sounding.YCOO / COMF);
+            }
+
+            pointFeature->point = soundingPool.GetPoint(pointFeature->soundingOffset);
         } else {
-            cout << "Error: Can't find SG2D or SG3D in RCID = " << RCID << endl;
+            if (DDFDiagnostics::Report(DDF_DC_CONTENT)) {
+                DDFDiagnostics::Post(DDF_DC_CONTENT, "Can't find SG2D or SG3D in RCID = " + to_string(RCID));
+            }
             
-            delete pointFeature;
-            pointFeature = nullptr;
+            pointNodes.Discard(pointFeature);
             
             return false;
         }
 
-        boundingRegion.Extend(pointFeature->point.x, pointFeature->point.y);
+        if (field) {
+            boundingRegion.Extend(pointFeature->point.x, pointFeature->point.y);
+        }
         
-        if (RCNM == ENC_RCNM_VI)
-            isolatedNodes[RCID] = pointFeature;
-        else
-            connectedNodes[RCID] = pointFeature;
+        pointNodes.Insert(RCID, pointFeature);
     } else if (RCNM == ENC_RCNM_VE) {
-        auto &&edgeFeature = new ENCEdgeGeometry(RCNM, RCID, RVER, RUIN);
-
-        if ((field = record->FindField("SG2D"))) {
-            auto &&count = field->GetRepeatCount();
-            edgeFeature->points.resize(count);
-            
-            for (auto idx = 0ul; idx < count; ++idx) {
-                auto &&x = field->GetSubfieldAsLong("XCOO", idx) / COMF;
-                auto &&y = field->GetSubfieldAsLong("YCOO", idx) / COMF;
-
-                boundingRegion.Extend(x, y);
-				edgeFeature->points[idx] = { x, y };
-            }
-        }
-
-        if ((field = record->FindField("VRPT")) && field->GetRepeatCount() == 2) {
-            auto binaryString = field->GetSubfieldAsBinary("NAME");
-
-            edgeFeature->beginNode.RCNM = static_cast<ENCrecordName>(*binaryString);
-            edgeFeature->beginNode.ORNT = static_cast<ENCorientation>(field->GetSubfieldAsLong("ORNT"));
-            edgeFeature->beginNode.USAG = static_cast<ENCusageIndicator>(field->GetSubfieldAsLong("USAG"));
-            edgeFeature->beginNode.MASK = static_cast<ENCmaskingIndicator>(field->GetSubfieldAsLong("MASK"));
-            edgeFeature->beginNode.TOPI = static_cast<ENCtopologyIndicator>(field->GetSubfieldAsLong("TOPI"));
-            edgeFeature->beginNode.RCID = binaryString[1] + (binaryString[2] * 256u) + (binaryString[3] * 65536u) + (binaryString[4] * 16777216u);
-
-            binaryString = field->GetSubfieldAsBinary("NAME", 1ul);
-
-            edgeFeature->endNode.RCNM = static_cast<ENCrecordName>(*binaryString);
-            edgeFeature->endNode.ORNT = static_cast<ENCorientation>(field->GetSubfieldAsLong("ORNT", 1ul));
-            edgeFeature->endNode.USAG = static_cast<ENCusageIndicator>(field->GetSubfieldAsLong("USAG", 1ul));
-            edgeFeature->endNode.MASK = static_cast<ENCmaskingIndicator>(field->GetSubfieldAsLong("MASK", 1ul));
-            edgeFeature->endNode.TOPI = static_cast<ENCtopologyIndicator>(field->GetSubfieldAsLong("TOPI", 1ul));
-            edgeFeature->endNode.RCID = binaryString[1] + (binaryString[2] * 256u) + (binaryString[3] * 65536u) + (binaryString[4] * 16777216u);
+        auto &&edgeFeature = edges.Construct(RCNM, RCID, vrid.RVER, vrid.RUIN);
+
+        if (!handles.VRPT.field) {
+            // The topology isn't part of the ingest profile.
+        } else if ((field = record->FindField(handles.VRPT.field)) && DecodeRepeats(field, vectorPointers) == 2 && vectorPointers[0].RCNM && vectorPointers[1].RCNM) {
+            auto &&beginPointer = vectorPointers[0];
+
+            edgeFeature->beginNode.RCNM = static_cast<ENCrecordName>(beginPointer.RCNM);
+            edgeFeature->beginNode.ORNT = static_cast<ENCorientation>(beginPointer.ORNT);
+            edgeFeature->beginNode.USAG = static_cast<ENCusageIndicator>(beginPointer.USAG);
+            edgeFeature->beginNode.MASK = static_cast<ENCmaskingIndicator>(beginPointer.MASK);
+            edgeFeature->beginNode.TOPI = static_cast<ENCtopologyIndicator>(beginPointer.TOPI);
+            edgeFeature->beginNode.RCID = beginPointer.RCID;
+
+            auto &&endPointer = vectorPointers[1];
+
+            edgeFeature->endNode.RCNM = static_cast<ENCrecordName>(endPointer.RCNM);
+            edgeFeature->endNode.ORNT = static_cast<ENCorientation>(endPointer.ORNT);
+            edgeFeature->endNode.USAG = static_cast<ENCusageIndicator>(endPointer.USAG);
+            edgeFeature->endNode.MASK = static_cast<ENCmaskingIndicator>(endPointer.MASK);
+            edgeFeature->endNode.TOPI = static_cast<ENCtopologyIndicator>(endPointer.TOPI);
+            edgeFeature->endNode.RCID = endPointer.RCID;
         } else {
-            cout << "Error: " << endl;
+            if (DDFDiagnostics::Report(DDF_DC_CONTENT)) {
+                DDFDiagnostics::Post(DDF_DC_CONTENT, "Can't find the two nodes of the edge in RCID = " + to_string(RCID));
+            }
             
-            delete edgeFeature;
-            edgeFeature = nullptr;
+            edges.Discard(edgeFeature);
             
             return false;
         }
+
+        // The vertices go to the pool once the edge is known to be kept.
+        if ((field = record->FindField(handles.SG2D.field))) {
+            edgeFeature->pointOffset = vertexPool.size();
+            edgeFeature->pointCount = DecodeRepeats(field, coordinates);
+
+            for (auto &&coordinate : coordinates) {
+                vertexPool.AddPoint(coordinate.XCOO, coordinate.YCOO);
+                boundingRegion.Extend(coordinate.XCOO / COMF, coordinate.YCOO / COMF);
+            }
+        }
         
-        edges[RCID] = edgeFeature;
+        edges.Insert(RCID, edgeFeature);
     } /*else if (RCNM == ENC_RCNM_VF) {
 
     }*/
@@ -278,67 +669,127 @@ const bool ENCChart::ReadVector(const DDFRecord *&record, const DDFField *&field
 }
 
 const bool ENCChart::ReadFeature(const DDFRecord *&record, const DDFField *&fieldFRID) noexcept{
-    auto &&PRIM = fieldFRID->GetSubfieldAsLong("PRIM");
+    const auto frid = DecodeField<ENCfieldFRID>(fieldFRID);
+    const auto PRIM = static_cast<ulong>(frid.PRIM);
 
     if (PRIM > ENC_PRIM_A/* && PRIM != ENC_PRIM_N */) {
-        cout << "ERROR: Unrecognised geometric object primitive code '" << PRIM << "'." << endl << "Field initialization incorrect." << endl;
+        if (DDFDiagnostics::Report(DDF_DC_CONTENT)) {
+            DDFDiagnostics::Post(DDF_DC_CONTENT, "Unrecognised geometric object primitive code '" + to_string(PRIM) + "', field initialization incorrect.");
+        }
         return false;
     }
 
-    auto &&RCNM = fieldFRID->GetSubfieldAsLong("RCNM");
-    auto &&RCID = fieldFRID->GetSubfieldAsLong("RCID");
-    auto &&RVER = fieldFRID->GetSubfieldAsLong("RVER");
-    auto &&RUIN = fieldFRID->GetSubfieldAsLong("RUIN");
+    const auto RCID = static_cast<ulong>(frid.RCID);
 
     const DDFField *field = nullptr;
-    auto &&primFeature = new ENCGeometryPrimitive(PRIM, RCNM, RCID, RVER, RUIN);
+    auto &&primFeature = features.Construct(PRIM, frid.RCNM, RCID, frid.RVER, frid.RUIN);
+
+    primFeature->GRUP = frid.GRUP;
+	primFeature->OBJL = static_cast<ENCobjectAcronymCodes>(frid.OBJL);
 
-    primFeature->GRUP = static_cast<byte>(fieldFRID->GetSubfieldAsLong("GRUP"));
-	primFeature->OBJL = static_cast<ENCobjectAcronymCodes>(fieldFRID->GetSubfieldAsLong("OBJL"));
+    if ((field = record->FindField(handles.FOID.field))) {
+        const auto foid = DecodeField<ENCfieldFOID>(field);
 
-    if ((field = record->FindField("FOID"))) {
-        primFeature->AGEN = field->GetSubfieldAsLong("AGEN");
-        primFeature->FIDN = field->GetSubfieldAsLong("FIDN");
-        primFeature->FIDS = field->GetSubfieldAsLong("FIDS");
+        primFeature->AGEN = foid.AGEN;
+        primFeature->FIDN = foid.FIDN;
+        primFeature->FIDS = foid.FIDS;
     }
 
-    if ((field = record->FindField("FSPT"))) {
-        auto &&count = field->GetRepeatCount();
+    if ((field = record->FindField(handles.FSPT.field))) {
+        auto &&count = DecodeRepeats(field, spatialPointers);
         primFeature->FSPTObjects.resize(count);
 
         ENCspatialRecordPointer record;
         for (auto idx = 0ul; idx < count; ++idx) {
-            auto binaryString = field->GetSubfieldAsBinary("NAME", idx);
+            auto &&spatialPointer = spatialPointers[idx];
 
-            record.RCNM = static_cast<ENCrecordName>(*binaryString);
-            record.ORNT = static_cast<ENCorientation>(field->GetSubfieldAsLong("ORNT", idx));
-            record.USAG = static_cast<ENCusageIndicator>(field->GetSubfieldAsLong("USAG", idx));
-            record.MASK = static_cast<ENCmaskingIndicator>(field->GetSubfieldAsLong("MASK", idx));
-            record.RCID = binaryString[1] + (binaryString[2] * 256u) + (binaryString[3] * 65536u) + (binaryString[4] * 16777216u);
+            if (!spatialPointer.RCNM) {
+                continue;
+            }
+
+            record.RCNM = static_cast<ENCrecordName>(spatialPointer.RCNM);
+            record.ORNT = static_cast<ENCorientation>(spatialPointer.ORNT);
+            record.USAG = static_cast<ENCusageIndicator>(spatialPointer.USAG);
+            record.MASK = static_cast<ENCmaskingIndicator>(spatialPointer.MASK);
+            record.RCID = spatialPointer.RCID;
 
             primFeature->FSPTObjects[idx] = record;
         }
     }
 
-    /*if ((field = record->FindField("ATTF"))) {
+    primFeature->attributeOffset = attributes.size();
 
-    }*/
+    if ((field = record->FindField(handles.ATTF.field))) {
+        ReadAttributes(field, handles.ATTF.ATTL, handles.ATTF.ATVL, AALL);
+    }
+
+    if ((field = record->FindField(handles.NATF.field))) {
+        ReadAttributes(field, handles.NATF.ATTL, handles.NATF.ATVL, NALL);
+    }
 
-    features[RCID] = primFeature;
+    primFeature->attributeCount = attributes.size() - primFeature->attributeOffset;
+
+    features.Insert(RCID, primFeature);
 
     return true;
 }
 
+void ENCChart::ReadAttributes(const DDFField *field, const DDFSubfieldHandle &ATTL, const DDFSubfieldHandle &ATVL, const long &lexicalLevel) noexcept {
+    const auto &&repeatCount = field->GetRepeatCount();
+
+    for (auto idx = 0ul; idx < repeatCount; ++idx) {
+        const auto &&attributeCode = static_cast<uint>(field->GetSubfieldAsLong(ATTL, idx));
+
+        if (!attributeCode || !profile.IsAttributeSelected(attributeCode)) {
+            continue;
+        }
+
+        ENCDecodeText(field->GetSubfieldAsBinaryView(ATVL, idx), lexicalLevel, attributeText);
+        attributes.AddAttribute(attributeCode, attributeText.data(), attributeText.size());
+    }
+}
+
+void ENCChart::IndexAttributes() noexcept {
+    // The rows of a feature replaced by a later record keep ENC_NO_FEATURE_IDX.
+    for (auto featureIdx = 0ul; featureIdx < features.size(); ++featureIdx) {
+        auto &&feature = features[featureIdx];
+
+        for (auto idx = 0ul; idx < feature.attributeCount; ++idx) {
+            attributes.featureIdxs[feature.attributeOffset + idx] = static_cast<uint>(featureIdx);
+        }
+    }
+}
+
+const char *ENCChart::GetAttributeValue(const ENCGeometryPrimitive *feature, const uint &attributeCode) const noexcept {
+    const auto &&idx = attributes.Find(feature->attributeOffset, feature->attributeCount, attributeCode);
+
+    return idx < attributes.size() ? attributes.GetValue(idx) : nullptr;
+}
+
+const map<ulong, ENCPointGeometry*> &ENCChart::GetConnectedNodes() const noexcept {
+    return BuildView(connectedNodes, connectedNodeView);
+}
+
+const map<ulong, ENCPointGeometry*> &ENCChart::GetIsolatedNodes() const noexcept {
+    return BuildView(isolatedNodes, isolatedNodeView);
+}
+
+const map<ulong, ENCEdgeGeometry*> &ENCChart::GetEdges() const noexcept {
+    return BuildView(edges, edgeView);
+}
+
+const map<ulong, ENCGeometryPrimitive*> &ENCChart::GetFeatures() const noexcept {
+    return BuildView(features, featureView);
+}
+
 void ENCChart::Close() noexcept{
     if (module) {
-        if (edges.size()) {
-            for (auto &&edge : edges) {
-                delete edge.second;
-                edge.second = nullptr;
-            }
+        edgeView.objects.clear();
+        featureView.objects.clear();
+        isolatedNodeView.objects.clear();
+        connectedNodeView.objects.clear();
 
-            edges.clear();
-        }
+        edges.Clear();
 
         /*if (faces.size()) {
             for (auto &&face : faces) {
@@ -349,35 +800,18 @@ void ENCChart::Close() noexcept{
             faces.clear();
         }*/
 
-        if (features.size()) {
-            for (auto &&feature : features) {
-                delete feature.second;
-                feature.second = nullptr;
-            }
-
-            features.clear();
-        }
+        features.Clear();
+        isolatedNodes.Clear();
+        connectedNodes.Clear();
 
-        if (isolatedNodes.size()) {
-            for (auto &&isolatedNode : isolatedNodes) {
-                delete isolatedNode.second;
-                isolatedNode.second = nullptr;
-            }
-
-            isolatedNodes.clear();
-        }
-
-        if (connectedNodes.size()) {
-            for (auto &&connectedNode : connectedNodes) {
-                delete connectedNode.second;
-                connectedNode.second = nullptr;
-            }
-
-            connectedNodes.clear();
-        }
+        vertexPool.Clear();
+        soundingPool.Clear();
+        attributes.Clear();
 
         delete module;
         module = nullptr;
+
+        handles = ENCsubfieldHandles();
     }
 
     if (DSNM) {
@@ -0,0 +1,85 @@
+//
+//  AllocationCount.cpp
+//  ihoS57
+//
+//  Counts the heap allocations made by DDFModule::ReadRecord() once the record
+//  storage is warmed up, in every open mode.  Build and run from ihoS57/Cpp:
+//
+//  g++ -std=c++11 -O2 -pthread -I. Tests/AllocationCount.cpp DDF*.cpp -o AllocationCount
+//  ./AllocationCount [file.000]
+//
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "iso8211.h"
+
+using namespace std;
+using namespace Standards;
+
+static atomic<size_t> allocationCount(0ul);
+
+void *operator new(size_t size) {
+    allocationCount.fetch_add(1ul, memory_order_relaxed);
+
+    if (auto &&memory = malloc(size ? size : 1ul)) {
+        return memory;
+    }
+
+    throw bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    free(memory);
+}
+
+/**
+ * Read every record twice, the first pass sizes the record storage (and the
+ * record index), only the second pass is counted.
+ */
+static const bool CountPass(DDFModule &module, const char *modeName) {
+    size_t recordCount = 0ul;
+    while (module.ReadRecord()) {
+        ++recordCount;
+    }
+
+    module.Rewind();
+
+    const auto &&startCount = allocationCount.load();
+    while (module.ReadRecord());
+    const auto &&passCount = allocationCount.load() - startCount;
+
+    cout << modeName << ": " << recordCount << " records, " << passCount << " allocations" << endl;
+
+    return recordCount && !passCount;
+}
+
+int main(int argc, const char * argv[]) {
+    const string fileName = argc > 1 ? argv[1] : "SAMPLE.000";
+    bool isPassed = true;
+
+    DDFModule bufferedModule;
+    isPassed = bufferedModule.Open(fileName, false, DDF_OM_BUFFERED) && CountPass(bufferedModule, "buffered") && isPassed;
+
+    DDFModule mappedModule;
+    isPassed = mappedModule.Open(fileName, false, DDF_OM_MAPPED) && CountPass(mappedModule, "mapped") && isPassed;
+
+    ifstream inputStream(fileName, ios::in | ios::binary);
+    DDFModule streamedModule;
+    isPassed = streamedModule.Open(inputStream) && CountPass(streamedModule, "streamed") && isPassed;
+
+    cout << (isPassed ? "PASSED" : "FAILED") << endl;
+
+    return isPassed ? 0 : 1;
+}
@@ -0,0 +1,665 @@
+//
+//  RecordChecks.cpp
+//  ihoS57
+//
+//  Checks of the record reading paths against each other on a real cell.
+//  Build and run from ihoS57/Cpp:
+//
+//  g++ -std=c++11 -O2 -pthread -I. Tests/RecordChecks.cpp DDF*.cpp ENCChart.cpp -o RecordChecks
+//  ./RecordChecks [file.000]
+//
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include "ihoS57.h"
+
+using namespace std;
+using namespace Standards;
+
+static const bool ReportCheck(const char *checkName, const bool isPassed) {
+    cout << checkName << ": " << (isPassed ? "ok" : "FAILED") << endl;
+
+    return isPassed;
+}
+
+/**
+ * Two modules on cells with the same DDR share the field definitions.
+ */
+static const bool CheckSharedDescriptiveRecord(const string &fileName) {
+    DDFModule firstModule;
+    DDFModule secondModule;
+
+    if (!firstModule.Open(fileName) || !secondModule.Open(fileName, false, DDF_OM_MAPPED)) {
+        return false;
+    }
+
+    auto &&fieldDefining = firstModule.FindFieldDefining("FRID");
+
+    if (!fieldDefining || fieldDefining != secondModule.FindFieldDefining("FRID") || firstModule.GetFieldCount() != secondModule.GetFieldCount()) {
+        return false;
+    }
+
+    // Once the cache is cleared the DDR is parsed again, the open modules keep theirs.
+    DDFModule::ClearDescriptiveCache();
+
+    DDFModule thirdModule;
+
+    return thirdModule.Open(fileName) && thirdModule.FindFieldDefining("FRID") != fieldDefining;
+}
+
+/**
+ * The decode plan of every field gives the values of the generic extractors,
+ * text subfields ('A') are only compared as views, the plan doesn't parse them.
+ */
+static const bool CheckDecodePlan(const string &fileName) {
+    DDFModule module;
+    if (!module.Open(fileName)) {
+        return false;
+    }
+
+    vector<DDFSubfieldValue> values;
+    size_t valueCount = 0ul;
+
+    const DDFRecord *record = nullptr;
+    while ((record = module.ReadRecord())) {
+        for (auto fieldIdx = 0ul; fieldIdx < record->GetFieldCount(); ++fieldIdx) {
+            auto &&field = record->GetField(fieldIdx);
+            if (!field) {
+                continue;
+            }
+
+            auto &&fieldDefining = field->GetFieldDefining();
+            const auto &&subfieldCount = fieldDefining->GetSubfieldCount();
+            const auto &&repeatCount = field->DecodeRepeats(values);
+
+            for (auto repeatIdx = 0ul; repeatIdx < repeatCount; ++repeatIdx) {
+                for (auto subfieldIdx = 0ul; subfieldIdx < subfieldCount; ++subfieldIdx) {
+                    auto &&subfieldName = fieldDefining->GetSubfieldDefining(subfieldIdx)->GetName();
+                    auto &&value = values[repeatIdx * subfieldCount + subfieldIdx];
+                    auto &&binaryView = field->GetSubfieldAsBinaryView(subfieldName, repeatIdx);
+
+                    if (value.binaryData.size != binaryView.size || (binaryView.size && memcmp(value.binaryData.data, binaryView.data, binaryView.size))) {
+                        return false;
+                    }
+
+                    if (fieldDefining->GetSubfieldDefining(subfieldIdx)->GetFormat() != 'A' &&
+                        (value.longValue != field->GetSubfieldAsLong(subfieldName, repeatIdx) || value.doubleValue != field->GetSubfieldAsDouble(subfieldName, repeatIdx))) {
+                        return false;
+                    }
+
+                    ++valueCount;
+                }
+            }
+        }
+    }
+
+    return valueCount > 0ul;
+}
+
+static const bool IsSame(const ENCfieldVRID &first, const ENCfieldVRID &second) {
+    return first.RCNM == second.RCNM && first.RCID == second.RCID && first.RVER == second.RVER && first.RUIN == second.RUIN;
+}
+
+static const bool IsSame(const ENCfieldFRID &first, const ENCfieldFRID &second) {
+    return first.RCNM == second.RCNM && first.RCID == second.RCID && first.PRIM == second.PRIM && first.GRUP == second.GRUP &&
+           first.OBJL == second.OBJL && first.RVER == second.RVER && first.RUIN == second.RUIN;
+}
+
+static const bool IsSame(const ENCfieldFOID &first, const ENCfieldFOID &second) {
+    return first.AGEN == second.AGEN && first.FIDN == second.FIDN && first.FIDS == second.FIDS;
+}
+
+static const bool IsSame(const ENCfieldFSPT &first, const ENCfieldFSPT &second) {
+    return first.RCNM == second.RCNM && first.RCID == second.RCID && first.ORNT == second.ORNT && first.USAG == second.USAG && first.MASK == second.MASK;
+}
+
+static const bool IsSame(const ENCfieldVRPT &first, const ENCfieldVRPT &second) {
+    return first.RCNM == second.RCNM && first.RCID == second.RCID && first.ORNT == second.ORNT && first.USAG == second.USAG &&
+           first.TOPI == second.TOPI && first.MASK == second.MASK;
+}
+
+static const bool IsSame(const ENCfieldSG2D &first, const ENCfieldSG2D &second) {
+    return first.XCOO == second.XCOO && first.YCOO == second.YCOO;
+}
+
+static const bool IsSame(const ENCfieldSG3D &first, const ENCfieldSG3D &second) {
+    return first.XCOO == second.XCOO && first.YCOO == second.YCOO && first.VE3D == second.VE3D;
+}
+
+/**
+ * Decode every repeat of a field with the fixed layout and through the handles.
+ * @return The number of repeats compared, or -1 if they differ.
+ */
+template<typename T>
+static const long CompareFixedLayout(const DDFRecord *record, const DDFFieldDefining *fieldDefining, const ENCsubfieldHandles &handles) {
+    auto &&field = record->FindField(fieldDefining);
+    if (!field) {
+        return 0l;
+    }
+
+    const auto &&repeatCount = field->GetRepeatCount();
+    if (field->GetDataSize() < repeatCount * S57Field<T>::GetWidth()) {
+        return -1l;
+    }
+
+    for (auto idx = 0ul; idx < repeatCount; ++idx) {
+        if (!IsSame(S57Field<T>::Decode(field->GetBinaryData() + idx * S57Field<T>::GetWidth()), S57Field<T>::Decode(field, idx, handles))) {
+            return -1l;
+        }
+    }
+
+    return static_cast<long>(repeatCount);
+}
+
+/**
+ * The fixed layouts of the core S-57 fields match the DDR of the cell, and
+ * decode to the same values as the generic path through the handles.
+ */
+static const bool CheckFixedLayouts(const string &fileName) {
+    DDFModule module;
+    if (!module.Open(fileName)) {
+        return false;
+    }
+
+    ENCsubfieldHandles handles;
+    handles.Resolve(module);
+
+    if (!handles.VRID.isLayoutValid || !handles.FRID.isLayoutValid || !handles.FOID.isLayoutValid || !handles.FSPT.isLayoutValid) {
+        return false;
+    }
+
+    long repeatCount = 0l;
+
+    const DDFRecord *record = nullptr;
+    while ((record = module.ReadRecord())) {
+        const long recordResults[] = {
+            handles.VRID.isLayoutValid ? CompareFixedLayout<ENCfieldVRID>(record, handles.VRID.field, handles) : 0l,
+            handles.VRPT.isLayoutValid ? CompareFixedLayout<ENCfieldVRPT>(record, handles.VRPT.field, handles) : 0l,
+            handles.SG2D.isLayoutValid ? CompareFixedLayout<ENCfieldSG2D>(record, handles.SG2D.field, handles) : 0l,
+            handles.SG3D.isLayoutValid ? CompareFixedLayout<ENCfieldSG3D>(record, handles.SG3D.field, handles) : 0l,
+            handles.FRID.isLayoutValid ? CompareFixedLayout<ENCfieldFRID>(record, handles.FRID.field, handles) : 0l,
+            handles.FOID.isLayoutValid ? CompareFixedLayout<ENCfieldFOID>(record, handles.FOID.field, handles) : 0l,
+            handles.FSPT.isLayoutValid ? CompareFixedLayout<ENCfieldFSPT>(record, handles.FSPT.field, handles) : 0l
+        };
+
+        for (auto &&recordResult : recordResults) {
+            if (recordResult < 0l) {
+                return false;
+            }
+
+            repeatCount += recordResult;
+        }
+    }
+
+    return repeatCount > 0l;
+}
+
+/**
+ * The tag and data of one field, as a single string.
+ */
+static const string FieldData(const DDFField *field) {
+    if (!field) {
+        return string();
+    }
+
+    return field->GetFieldDefining()->GetName() + string(reinterpret_cast<const char*>(field->GetBinaryData()), field->GetDataSize());
+}
+
+/**
+ * Read every record of a stream, each one as the list of it's field tags and data.
+ */
+static const vector<vector<string>> ReadFieldData(const string &fileData) {
+    vector<vector<string>> records;
+
+    istringstream inputStream(fileData);
+    DDFModule module;
+    if (!module.Open(inputStream)) {
+        return records;
+    }
+
+    const DDFRecord *record = nullptr;
+    while ((record = module.ReadRecord())) {
+        records.emplace_back();
+
+        for (auto fieldIdx = 0ul; fieldIdx < record->GetFieldCount(); ++fieldIdx) {
+            records.back().push_back(FieldData(record->GetField(fieldIdx)));
+        }
+    }
+
+    return records;
+}
+
+/**
+ * A data record whose leader and directory are reused ('R') followed by bare
+ * field areas reads the same fields as the full records.  The cell has no
+ * such records, so both layouts are written from one of it's vector records
+ * with a different RCID in each copy.
+ */
+static const bool CheckReuseHeader(const string &fileName) {
+    ifstream inputFile(fileName, ios::in | ios::binary);
+    const string cellData((istreambuf_iterator<char>(inputFile)), istreambuf_iterator<char>());
+
+    DDFModule module;
+    if (cellData.size() < DDF_LEADER_SIZE || !module.Open(fileName, false, DDF_OM_MAPPED)) {
+        return false;
+    }
+
+    const auto &&descriptiveLenght = static_cast<size_t>(stoul(cellData.substr(0, 5)));
+
+    string recordData;
+    size_t rcidOffset = 0ul;
+
+    const DDFRecord *record = nullptr;
+    while ((record = module.ReadRecord())) {
+        if (auto &&field = record->FindField("VRID")) {
+            auto &&recordStart = record->GetBinaryData() - DDF_LEADER_SIZE;
+
+            recordData.assign(reinterpret_cast<const char*>(recordStart), record->GetDataSize() + DDF_LEADER_SIZE);
+            rcidOffset = field->GetBinaryData() - recordStart + 1ul;
+            break;
+        }
+    }
+
+    if (recordData.empty()) {
+        return false;
+    }
+
+    const auto &&fieldAreaStart = static_cast<size_t>(stoul(recordData.substr(12, 5)));
+    string fullData = cellData.substr(0, descriptiveLenght);
+    string reusedData = fullData;
+
+    for (auto copyIdx = 0u; copyIdx < 4u; ++copyIdx) {
+        const auto rcid = 1000u + copyIdx;
+        for (auto byteIdx = 0u; byteIdx < 4u; ++byteIdx) {
+            recordData[rcidOffset + byteIdx] = static_cast<char>((rcid >> (byteIdx * 8u)) & 0xFFu);
+        }
+
+        fullData += recordData;
+
+        if (!copyIdx) {
+            reusedData += recordData;
+            reusedData[descriptiveLenght + 6] = 'R';
+        } else {
+            reusedData += recordData.substr(fieldAreaStart);
+        }
+    }
+
+    auto &&fullRecords = ReadFieldData(fullData);
+
+    return fullRecords.size() == 4ul && fullRecords[0] != fullRecords[3] && fullRecords == ReadFieldData(reusedData);
+}
+
+/**
+ * A lazily decoded directory gives the fields of the eager one, whatever the
+ * order they are asked for: the last field is found by name first, then the
+ * fields are fetched backwards.
+ */
+static const bool CheckLazyDirectory(const string &fileName) {
+    DDFModule eagerModule;
+    DDFModule lazyModule;
+
+    lazyModule.SetLazyDirectory(true);
+
+    if (!eagerModule.Open(fileName) || !lazyModule.Open(fileName, false, DDF_OM_MAPPED)) {
+        return false;
+    }
+
+    size_t fieldCount = 0ul;
+
+    const DDFRecord *eagerRecord = nullptr;
+    while ((eagerRecord = eagerModule.ReadRecord())) {
+        auto &&lazyRecord = lazyModule.ReadRecord();
+        if (!lazyRecord || lazyRecord->GetFieldCount() != eagerRecord->GetFieldCount() || !eagerRecord->GetFieldCount()) {
+            return false;
+        }
+
+        auto &&lastField = eagerRecord->GetField(eagerRecord->GetFieldCount() - 1ul);
+        if (FieldData(lazyRecord->FindField(lastField->GetFieldDefining())) != FieldData(eagerRecord->FindField(lastField->GetFieldDefining()))) {
+            return false;
+        }
+
+        for (auto fieldIdx = eagerRecord->GetFieldCount(); fieldIdx-- > 0ul; ++fieldCount) {
+            if (FieldData(lazyRecord->GetField(fieldIdx)) != FieldData(eagerRecord->GetField(fieldIdx))) {
+                return false;
+            }
+        }
+    }
+
+    return fieldCount > 0ul && !lazyModule.ReadRecord();
+}
+
+/**
+ * Collect the fields of the records a filter reads, or with an empty filter
+ * the fields of the records selected by looking at their fields.
+ */
+static const vector<vector<string>> SelectRecords(const string &fileName, const initializer_list<string> &recordTags, const initializer_list<string> &requiredTags, const bool isFiltered) {
+    vector<vector<string>> records;
+
+    DDFModule module;
+    if (!module.Open(fileName)) {
+        return records;
+    }
+
+    const DDFRecordFilter recordFilter(recordTags, requiredTags);
+
+    const DDFRecord *record = nullptr;
+    while ((record = isFiltered ? module.ReadRecord(recordFilter) : module.ReadRecord())) {
+        if (!isFiltered) {
+            auto &&recordField = record->GetField(record->GetFieldCount() > 1ul && record->GetField(0ul)->GetFieldDefining()->GetName() == "0001" ? 1ul : 0ul);
+            bool isSelected = recordField && (!recordTags.size() || find(recordTags.begin(), recordTags.end(), recordField->GetFieldDefining()->GetName()) != recordTags.end());
+
+            for (auto &&requiredTag : requiredTags) {
+                isSelected = isSelected && record->FindField(requiredTag);
+            }
+
+            if (!isSelected) {
+                continue;
+            }
+        }
+
+        records.emplace_back();
+
+        for (auto fieldIdx = 0ul; fieldIdx < record->GetFieldCount(); ++fieldIdx) {
+            records.back().push_back(FieldData(record->GetField(fieldIdx)));
+        }
+    }
+
+    return records;
+}
+
+/**
+ * Reading with a filter returns exactly the records, in order, selected by
+ * looking at their first data field and the fields they have.
+ * @return The number of records selected, or -1 if they differ.
+ */
+static const long CompareRecordFilter(const string &fileName, const initializer_list<string> &recordTags, const initializer_list<string> &requiredTags) {
+    auto &&records = SelectRecords(fileName, recordTags, requiredTags, true);
+
+    if (records != SelectRecords(fileName, recordTags, requiredTags, false)) {
+        return -1l;
+    }
+
+    return static_cast<long>(records.size());
+}
+
+static const bool CheckRecordFilter(const string &fileName) {
+    const long results[] = {
+        CompareRecordFilter(fileName, { "VRID" }, {}),
+        CompareRecordFilter(fileName, { "VRID" }, { "SG2D" }),
+        CompareRecordFilter(fileName, { "FRID", "VRID" }, { "ATTF" }),
+        CompareRecordFilter(fileName, { "FRID" }, { "FOID", "FSPT" }),
+        CompareRecordFilter(fileName, {}, { "SG3D" }),
+        CompareRecordFilter(fileName, { "DSID" }, {})
+    };
+
+    long recordCount = 0l;
+    for (auto &&result : results) {
+        if (result < 0l) {
+            return false;
+        }
+
+        recordCount += result;
+    }
+
+    return recordCount > 0l;
+}
+
+/**
+ * Append an unsigned little endian binary subfield.
+ */
+static void AppendBinary(string &fieldData, const ulong value, const uint byteCount) {
+    for (auto byteIdx = 0u; byteIdx < byteCount; ++byteIdx) {
+        fieldData.push_back(static_cast<char>((value >> (byteIdx * 8u)) & 0xFFu));
+    }
+}
+
+/**
+ * Write a data record with a 0001 record identifier and the given fields, each
+ * one is the tag and the subfields, the field terminator is added.
+ */
+static const string WriteRecord(const ulong recordId, const vector<pair<string, string>> &fields) {
+    string recordIdField;
+    AppendBinary(recordIdField, recordId, 2u);
+
+    vector<pair<string, string>> recordFields(1ul, make_pair(string("0001"), recordIdField));
+    recordFields.insert(recordFields.end(), fields.begin(), fields.end());
+
+    string directoryData;
+    string fieldArea;
+    char fieldEntry[16];
+
+    for (auto &&recordField : recordFields) {
+        snprintf(fieldEntry, sizeof(fieldEntry), "%s%03zu%04zu", recordField.first.c_str(), recordField.second.size() + 1ul, fieldArea.size());
+
+        directoryData += fieldEntry;
+        fieldArea += recordField.second + static_cast<char>(DDF_FIELD_TERMINATOR);
+    }
+
+    directoryData.push_back(static_cast<char>(DDF_FIELD_TERMINATOR));
+
+    char leaderData[DDF_LEADER_SIZE + 1];
+    snprintf(leaderData, sizeof(leaderData), "%05zu D     %05zu   3404", DDF_LEADER_SIZE + directoryData.size() + fieldArea.size(), DDF_LEADER_SIZE + directoryData.size());
+
+    return leaderData + directoryData + fieldArea;
+}
+
+/**
+ * An edge between two connected nodes, with a few SG2D vertices moved by shift.
+ */
+static const string WriteEdge(const ulong recordId, const ulong RCID, const int shift) {
+    string vrid;
+    AppendBinary(vrid, ENC_RCNM_VE, 1u);
+    AppendBinary(vrid, RCID, 4u);
+    AppendBinary(vrid, 1ul, 2u);
+    AppendBinary(vrid, ENC_RUIN_I, 1u);
+
+    string vrpt;
+    for (auto nodeIdx = 0ul; nodeIdx < 2ul; ++nodeIdx) {
+        AppendBinary(vrpt, ENC_RCNM_VC, 1u);
+        AppendBinary(vrpt, 300ul + RCID % 7ul + nodeIdx, 4u);
+        AppendBinary(vrpt, ENC_ORNT_N, 1u);
+        AppendBinary(vrpt, ENC_USAG_N, 1u);
+        AppendBinary(vrpt, nodeIdx + 1ul, 1u);
+        AppendBinary(vrpt, ENC_MASK_N, 1u);
+    }
+
+    string sg2d;
+    for (auto vertexIdx = 0ul; vertexIdx < 2ul + RCID % 5ul; ++vertexIdx) {
+        AppendBinary(sg2d, static_cast<uint>(-4000000 + static_cast<int>(RCID * 1000ul + vertexIdx * 37ul) + shift), 4u);
+        AppendBinary(sg2d, static_cast<uint>(1500000 - static_cast<int>(RCID * 700ul + vertexIdx * 53ul) - shift), 4u);
+    }
+
+    return WriteRecord(recordId, { make_pair(string("VRID"), vrid), make_pair(string("VRPT"), vrpt), make_pair(string("SG2D"), sg2d) });
+}
+
+/**
+ * An isolated node with a few SG3D soundings, moved and deepened by shift.
+ */
+static const string WriteSoundings(const ulong recordId, const ulong RCID, const int shift) {
+    string vrid;
+    AppendBinary(vrid, ENC_RCNM_VI, 1u);
+    AppendBinary(vrid, RCID, 4u);
+    AppendBinary(vrid, 1ul, 2u);
+    AppendBinary(vrid, ENC_RUIN_I, 1u);
+
+    string sg3d;
+    for (auto soundingIdx = 0ul; soundingIdx < 1ul + RCID % 4ul; ++soundingIdx) {
+        AppendBinary(sg3d, static_cast<uint>(-3000000 + static_cast<int>(RCID * 900ul + soundingIdx * 11ul) + shift), 4u);
+        AppendBinary(sg3d, static_cast<uint>(2500000 - static_cast<int>(RCID * 400ul + soundingIdx * 13ul) - shift), 4u);
+        AppendBinary(sg3d, static_cast<uint>(static_cast<int>(RCID % 50ul + soundingIdx) * 10 + shift), 4u);
+    }
+
+    return WriteRecord(recordId, { make_pair(string("VRID"), vrid), make_pair(string("SG3D"), sg3d) });
+}
+
+/**
+ * Everything Ingest() built, with the coordinates as hexadecimal floats so equal
+ * text means equal bits.  The raw integers are added with isRawDumped.
+ */
+static const string DumpChart(const ENCChart &chart, const bool isRawDumped) {
+    ostringstream dump;
+    dump << hexfloat;
+
+    auto &&vertexPool = chart.GetVertexPool();
+    auto &&soundingPool = chart.GetSoundingPool();
+    auto &&attributes = chart.GetAttributes();
+
+    auto &&dumpPoint = [&dump, isRawDumped](const ENCcoordinatePool &pool, const size_t &idx) {
+        auto &&point = pool.GetPoint(idx);
+        dump << ' ' << point.x << ',' << point.y << ',' << point.z;
+
+        if (isRawDumped) {
+            dump << " (" << pool.rawX[idx] << ',' << pool.rawY[idx] << ',' << (pool.rawZ.empty() ? 0 : pool.rawZ[idx]) << ')';
+        }
+    };
+
+    for (auto &&edge : chart.GetEdgeStore()) {
+        dump << "VE " << edge->GetRCID() << ' ' << edge->GetBeginNode().RCID << ' ' << edge->GetEndNode().RCID << ':';
+
+        for (auto idx = 0ul; idx < edge->GetPointCount(); ++idx) {
+            dumpPoint(vertexPool, edge->GetPointOffset() + idx);
+        }
+
+        dump << '\n';
+    }
+
+    for (auto &&nodeStore : { &chart.GetIsolatedNodeStore(), &chart.GetConnectedNodeStore() }) {
+        for (auto &&node : *nodeStore) {
+            dump << "VN " << node->GetRCNM() << ' ' << node->GetRCID() << ' ' << node->GetPointRef().x << ',' << node->GetPointRef().y << ':';
+
+            for (auto idx = 0ul; idx < node->GetPointCount(); ++idx) {
+                dumpPoint(vertexPool, node->GetPointOffset() + idx);
+            }
+
+            for (auto idx = 0ul; idx < node->GetSoundingCount(); ++idx) {
+                dumpPoint(soundingPool, node->GetSoundingOffset() + idx);
+            }
+
+            dump << '\n';
+        }
+    }
+
+    for (auto &&feature : chart.GetFeatureStore()) {
+        dump << "FE " << feature->GetRCID() << ' ' << feature->GetOBJL() << ':';
+
+        for (auto &&pointer : feature->GetFSPTObjects()) {
+            dump << ' ' << pointer.RCNM << '/' << pointer.RCID;
+        }
+
+        for (auto idx = feature->GetAttributeOffset(); idx < feature->GetAttributeOffset() + feature->GetAttributeCount(); ++idx) {
+            dump << ' ' << attributes.codes[idx] << '=' << attributes.GetValue(idx);
+        }
+
+        dump << '\n';
+    }
+
+    auto &&boundingRegion = chart.GetBoundingBox();
+    dump << "BB " << boundingRegion.minX << ',' << boundingRegion.minY << ',' << boundingRegion.maxX << ',' << boundingRegion.maxY << '\n';
+
+    return dump.str();
+}
+
+static const string IngestChart(const string &chartName, const uint threadCount, const ENCcoordinateStorage coordinateStorage, const bool isRawDumped) {
+    ENCChart chart(chartName);
+    chart.SetCoordinateStorage(coordinateStorage);
+
+    if (!chart.Open() || !chart.Ingest(threadCount)) {
+        return string();
+    }
+
+    return DumpChart(chart, isRawDumped);
+}
+
+/**
+ * Ingest(N) builds the chart Ingest(1) does.  The cell has no edges nor soundings,
+ * so they are written after it's own records, then some of the edges, soundings,
+ * nodes and features again with other coordinates: the spans of the workers hold
+ * records with the same RCID and the later ones must win, as when read in order.
+ */
+static const bool CheckParallelIngest(const string &fileName) {
+    ifstream inputFile(fileName, ios::in | ios::binary);
+    const string cellData((istreambuf_iterator<char>(inputFile)), istreambuf_iterator<char>());
+
+    DDFModule module;
+    if (cellData.size() < DDF_LEADER_SIZE || !module.Open(fileName)) {
+        return false;
+    }
+
+    vector<string> cellRecords;
+    for (auto recordOffset = static_cast<size_t>(stoul(cellData.substr(0, 5))); recordOffset + DDF_LEADER_SIZE <= cellData.size();) {
+        const auto &&recordLenght = static_cast<size_t>(stoul(cellData.substr(recordOffset, 5)));
+
+        cellRecords.push_back(cellData.substr(recordOffset, recordLenght));
+        recordOffset += recordLenght;
+    }
+
+    string chartData = cellData;
+    ulong recordId = cellRecords.size() + 1ul;
+
+    for (auto RCID = 100ul; RCID < 124ul; ++RCID) {
+        chartData += WriteEdge(recordId++, RCID, 0);
+    }
+
+    for (auto RCID = 200ul; RCID < 212ul; ++RCID) {
+        chartData += WriteSoundings(recordId++, RCID, 0);
+    }
+
+    // The replacements, the sample's own nodes and features are read again as they are.
+    for (auto idx = 1ul; idx < cellRecords.size(); ++idx) {
+        chartData += cellRecords[idx];
+    }
+
+    for (auto RCID = 100ul; RCID < 108ul; ++RCID) {
+        chartData += WriteEdge(recordId++, RCID, 5000);
+    }
+
+    for (auto RCID = 200ul; RCID < 204ul; ++RCID) {
+        chartData += WriteSoundings(recordId++, RCID, 70);
+    }
+
+    chartData += WriteEdge(recordId++, 124ul, 0);
+    chartData += WriteEdge(recordId++, 102ul, 9000);
+    chartData += WriteSoundings(recordId++, 212ul, 0);
+
+    const string chartName = "RecordChecks.000";
+    {
+        ofstream chartFile(chartName, ios::out | ios::binary | ios::trunc);
+        chartFile << chartData;
+    }
+
+    const auto &&sequentialDump = IngestChart(chartName, 1u, ENC_CS_SCALED, false);
+    const auto &&rawDump = IngestChart(chartName, 1u, ENC_CS_RAW, true);
+
+    const bool isPassed = !sequentialDump.empty() && !rawDump.empty() &&
+        IngestChart(chartName, 4u, ENC_CS_SCALED, false) == sequentialDump &&
+        IngestChart(chartName, 3u, ENC_CS_SCALED, false) == sequentialDump &&
+        IngestChart(chartName, 4u, ENC_CS_RAW, false) == sequentialDump &&
+        IngestChart(chartName, 4u, ENC_CS_RAW, true) == rawDump &&
+        IngestChart(chartName, 3u, ENC_CS_RAW, true) == rawDump;
+
+    remove(chartName.c_str());
+
+    return isPassed;
+}
+
+int main(int argc, const char * argv[]) {
+    const string fileName = argc > 1 ? argv[1] : "SAMPLE.000";
+    bool isPassed = true;
+
+    isPassed = ReportCheck("shared DDR", CheckSharedDescriptiveRecord(fileName)) && isPassed;
+    isPassed = ReportCheck("decode plan", CheckDecodePlan(fileName)) && isPassed;
+    isPassed = ReportCheck("fixed layouts", CheckFixedLayouts(fileName)) && isPassed;
+    isPassed = ReportCheck("reuse header", CheckReuseHeader(fileName)) && isPassed;
+    isPassed = ReportCheck("lazy directory", CheckLazyDirectory(fileName)) && isPassed;
+    isPassed = ReportCheck("record filter", CheckRecordFilter(fileName)) && isPassed;
+    isPassed = ReportCheck("parallel ingest", CheckParallelIngest(fileName)) && isPassed;
+
+    cout << (isPassed ? "PASSED" : "FAILED") << endl;
+
+    return isPassed ? 0 : 1;
+}
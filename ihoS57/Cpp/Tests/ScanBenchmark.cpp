@@ -0,0 +1,143 @@
+//
+//  ScanBenchmark.cpp
+//  ihoS57
+//
+//  Times DDFFindDelimiter() against the byte loop it replaced, and DDFParseInt()
+//  against the copy and stoi parser DDFScanInt() used to be, checking that both
+//  pairs agree.  Build and run from ihoS57/Cpp:
+//
+//  g++ -std=c++11 -O2 -pthread -I. Tests/ScanBenchmark.cpp DDF*.cpp -o ScanBenchmark
+//  ./ScanBenchmark
+//
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstring>
+#include <iostream>
+
+#include "iso8211.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace Standards;
+
+#define SCAN_BUFFER_SIZE    0x100000
+#define SCAN_REPEAT_COUNT   2000u
+#define PARSE_VALUE_COUNT   0x1000
+#define PARSE_REPEAT_COUNT  2000u
+
+/**
+ * The terminator search of GetDataLenght() before the SIMD kernels.
+ */
+static size_t ByteLoopFindDelimiter(const byte *sourceData, const size_t &dataSize) noexcept {
+    size_t idx = 0ul;
+    for (; idx < dataSize && sourceData[idx] != DDF_UNIT_TERMINATOR && sourceData[idx] != DDF_FIELD_TERMINATOR; ++idx);
+
+    return idx;
+}
+
+/**
+ * DDFScanInt() before DDFParseInt(): copy into a buffer and call stoi.
+ */
+static int StoiScanInt(const char *strSource, byte byteRead) {
+    char strBuffer[33];
+
+    if (byteRead > 32 || !byteRead) {
+        byteRead = 32;
+    }
+
+    memcpy(strBuffer, strSource, byteRead);
+    strBuffer[byteRead] = '\0';
+
+    return stoi(strBuffer, nullptr, 10);
+}
+
+template<typename Function>
+static const double TimeSeconds(Function &&function) {
+    auto &&start = high_resolution_clock::now();
+    function();
+
+    return duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+}
+
+int main(int argc, const char * argv[]) {
+    mt19937 generator(8211u);
+    bool isPassed = true;
+
+    // Subfield text without terminators, then one terminator at the end.
+    vector<byte> scanBuffer(SCAN_BUFFER_SIZE);
+    uniform_int_distribution<int> textByte(0x20, 0x7E);
+
+    for (auto &&character : scanBuffer) {
+        character = static_cast<byte>(textByte(generator));
+    }
+
+    scanBuffer.back() = DDF_FIELD_TERMINATOR;
+
+    // Short values as found in real records, checked against the byte loop.
+    uniform_int_distribution<size_t> offsetPick(0ul, SCAN_BUFFER_SIZE - 1ul);
+    for (auto idx = 0u; idx < 0x10000u; ++idx) {
+        const size_t dataSize = idx % 97u;
+        auto &&sourceData = scanBuffer.data() + offsetPick(generator) % (SCAN_BUFFER_SIZE - dataSize);
+
+        vector<byte> value(sourceData, sourceData + dataSize);
+        if (dataSize) {
+            value[idx % dataSize] = idx & 1u ? DDF_UNIT_TERMINATOR : DDF_FIELD_TERMINATOR;
+        }
+
+        isPassed = DDFFindDelimiter(value.data(), value.size()) == ByteLoopFindDelimiter(value.data(), value.size()) && isPassed;
+    }
+
+    size_t scanSum = 0ul;
+    const auto &&byteLoopTime = TimeSeconds([&]() {
+        for (auto idx = 0u; idx < SCAN_REPEAT_COUNT; ++idx) {
+            scanSum += ByteLoopFindDelimiter(scanBuffer.data(), scanBuffer.size());
+        }
+    });
+
+    const auto &&findTime = TimeSeconds([&]() {
+        for (auto idx = 0u; idx < SCAN_REPEAT_COUNT; ++idx) {
+            scanSum -= DDFFindDelimiter(scanBuffer.data(), scanBuffer.size());
+        }
+    });
+
+    isPassed = !scanSum && isPassed;
+
+    cout << "1 MiB terminator scan x" << SCAN_REPEAT_COUNT << ": byte loop " << byteLoopTime * 1000.0 << " ms, DDFFindDelimiter " << findTime * 1000.0 << " ms" << endl;
+
+    // Five digit leader and directory numbers, zero padded.
+    vector<char> parseBuffer(PARSE_VALUE_COUNT * 5);
+    uniform_int_distribution<int> numberPick(0, 99999);
+
+    for (auto idx = 0ul; idx < PARSE_VALUE_COUNT; ++idx) {
+        const auto &&number = to_string(100000 + numberPick(generator));
+        memcpy(parseBuffer.data() + idx * 5, number.data() + 1, 5);
+    }
+
+    long parseSum = 0l;
+    const auto &&stoiTime = TimeSeconds([&]() {
+        for (auto repeat = 0u; repeat < PARSE_REPEAT_COUNT; ++repeat) {
+            for (auto idx = 0ul; idx < PARSE_VALUE_COUNT; ++idx) {
+                parseSum += StoiScanInt(parseBuffer.data() + idx * 5, 5);
+            }
+        }
+    });
+
+    const auto &&parseTime = TimeSeconds([&]() {
+        for (auto repeat = 0u; repeat < PARSE_REPEAT_COUNT; ++repeat) {
+            for (auto idx = 0ul; idx < PARSE_VALUE_COUNT; ++idx) {
+                size_t value = 0ul;
+                isPassed = DDFParseInt(parseBuffer.data() + idx * 5, 5, &value) && isPassed;
+                parseSum -= static_cast<long>(value);
+            }
+        }
+    });
+
+    isPassed = !parseSum && isPassed;
+
+    cout << "5 digit numbers x" << PARSE_VALUE_COUNT * PARSE_REPEAT_COUNT << ": copy and stoi " << stoiTime * 1000.0 << " ms, DDFParseInt " << parseTime * 1000.0 << " ms" << endl;
+    cout << (isPassed ? "PASSED" : "FAILED") << endl;
+
+    return isPassed ? 0 : 1;
+}
@@ -11,10 +11,16 @@
 #define __Standards__ihoS57__
 
 #include <map>
+#include <new>
 #include <cmath>
+#include <cstring>
+#include <utility>
 
 #include "iso8211.h"
 
+#define ENC_STORE_BLOCK_SIZE    0x400
+#define ENC_NO_FEATURE_IDX      0xFFFFFFFFu
+
 namespace Standards {
     /**
      * Predeclarations
@@ -53,11 +59,14 @@ namespace Standards {
 		}
 
 		/**
-		* Extend the bounding box with a point
-		* @param x the x coordinate
-		* @param y the y coordinate
+		* Extend the bounding box with an other bounding box
+		* @param bbox the bounding box, ignored if it isn't valid
 		*/
 		inline void Extend(const ENCboundingBox &bbox) noexcept {
+			if (!bbox.isValid) {
+				return;
+			}
+
 			if (isValid) {
 				minX = std::min(minX, bbox.minX);
 				minY = std::min(minY, bbox.minY);
@@ -68,7 +77,7 @@ namespace Standards {
 				isValid = true;
 				minX = bbox.minX;
 				maxX = bbox.maxX;
-				minY = bbox.minX;
+				minY = bbox.minY;
 				maxY = bbox.maxY;
 			}
 		}
@@ -125,6 +134,314 @@ namespace Standards {
 		 */
 		~Vector3() noexcept = default;
 	};
+
+    /**
+     * How ENCChart::Ingest() stores the coordinates of the coordinate pools.
+     */
+    enum ENCcoordinateStorage : byte {
+        /**
+         * Divided by the multiplication factors (COMF, SOMF) while read, as doubles
+         */
+        ENC_CS_SCALED = 0u,
+        /**
+         * The integers as read, scaled on demand or by ENCcoordinatePool::Scale()
+         */
+        ENC_CS_RAW
+    };
+
+    /**
+     * Coordinates of a chart as a structure of arrays, the vertices of all the
+     * objects one after an other.  The z arrays are only filled for 3-D (sounding)
+     * coordinates, an object refers to it's vertices by offset and count.
+     * @see ENCcoordinateStorage
+     */
+    struct ENCcoordinatePool {
+        vector<double> x;
+        vector<double> y;
+        vector<double> z;
+
+        /**
+         * The coordinates as read (XCOO, YCOO, VE3D), only filled with ENC_CS_RAW.
+         */
+        vector<int> rawX;
+        vector<int> rawY;
+        vector<int> rawZ;
+
+        /**
+         * The multiplication factors of the chart, the raw coordinates are divided by.
+         */
+        double COMF = 1.0;
+        double SOMF = 1.0;
+
+        bool isRaw = false;
+
+        /**
+         * The constructor.
+         */
+        ENCcoordinatePool() noexcept : x(), y(), z(), rawX(), rawY(), rawZ() { }
+
+        /**
+         * Gets the number of vertices.
+         */
+        inline const size_t size() const noexcept { return isRaw ? rawX.size() : x.size(); }
+
+        /**
+         * Check if the scaled arrays hold every vertex, always true with ENC_CS_SCALED.
+         */
+        inline const bool IsScaled() const noexcept { return x.size() == size(); }
+
+        /**
+         * Gets a vertex, scaled on demand if Scale() wasn't called, z is 0 for 2-D coordinates.
+         * @param idx Between 0 and size()-1.
+         */
+        inline const Vector3 GetPoint(const size_t &idx) const noexcept {
+            if (!IsScaled()) {
+                return Vector3(rawX[idx] / COMF, rawY[idx] / COMF, rawZ.empty() ? 0.0 : rawZ[idx] / SOMF);
+            }
+
+            return Vector3(x[idx], y[idx], z.empty() ? 0.0 : z[idx]);
+        }
+
+        /**
+         * Add a 2-D vertex as read from a SG2D field.
+         */
+        inline void AddPoint(const int &xcoo, const int &ycoo) noexcept {
+            if (isRaw) {
+                rawX.push_back(xcoo);
+                rawY.push_back(ycoo);
+            } else {
+                x.push_back(xcoo / COMF);
+                y.push_back(ycoo / COMF);
+            }
+        }
+
+        /**
+         * Add a 3-D vertex as read from a SG3D field.
+         */
+        inline void AddPoint(const int &xcoo, const int &ycoo, const int &ve3d) noexcept {
+            AddPoint(xcoo, ycoo);
+
+            if (isRaw) {
+                rawZ.push_back(ve3d);
+            } else {
+                z.push_back(ve3d / SOMF);
+            }
+        }
+
+        /**
+         * Fill the scaled arrays from the raw ones in a single pass, the raw ones are kept.
+         */
+        void Scale() noexcept {
+            if (!isRaw) {
+                return;
+            }
+
+            const auto count = rawX.size();
+            x.resize(count);
+            y.resize(count);
+            z.resize(rawZ.size());
+
+            for (auto idx = 0ul; idx < count; ++idx) {
+                x[idx] = rawX[idx] / COMF;
+                y[idx] = rawY[idx] / COMF;
+            }
+
+            for (auto idx = 0ul; idx < rawZ.size(); ++idx) {
+                z[idx] = rawZ[idx] / SOMF;
+            }
+        }
+
+        /**
+         * Add the vertices of an other pool, stored the same way, at the end of this one.
+         */
+        inline void Append(const ENCcoordinatePool &pool) noexcept {
+            x.insert(x.end(), pool.x.begin(), pool.x.end());
+            y.insert(y.end(), pool.y.begin(), pool.y.end());
+            z.insert(z.end(), pool.z.begin(), pool.z.end());
+
+            rawX.insert(rawX.end(), pool.rawX.begin(), pool.rawX.end());
+            rawY.insert(rawY.end(), pool.rawY.begin(), pool.rawY.end());
+            rawZ.insert(rawZ.end(), pool.rawZ.begin(), pool.rawZ.end());
+        }
+
+        /**
+         * Remove all the vertices and release the memory.
+         */
+        inline void Clear() noexcept {
+            vector<double>().swap(x);
+            vector<double>().swap(y);
+            vector<double>().swap(z);
+
+            vector<int>().swap(rawX);
+            vector<int>().swap(rawY);
+            vector<int>().swap(rawZ);
+        }
+    };
+
+    /**
+     * Lexical level of the text of the ATTF and NATF fields (see 2.4)
+     */
+    enum ENClexicalLevel : byte {
+        /**
+         * ASCII text, IRV of ISO/IEC 646
+         */
+        ENC_LL_0 = 0u,
+        /**
+         * Latin alphabet 1, ISO 8859-1
+         */
+        ENC_LL_1 = 1u,
+        /**
+         * Universal Character Set, ISO/IEC 10646 level 1 (UCS-2)
+         */
+        ENC_LL_2 = 2u
+    };
+
+    /**
+     * The attributes (ATTF, NATF) of all the features of a chart as a structure of
+     * arrays, one row per attribute.  The values are UTF-8 and zero terminated, each
+     * distinct value is kept once in the value pool and found again through an open
+     * addressing table.  A feature refers to it's own rows by offset and count.
+     */
+    struct ENCattributeStore {
+        /**
+         * Index of the feature in ENCChart::GetFeatureStore(),
+         * ENC_NO_FEATURE_IDX for the rows of a replaced feature.
+         */
+        vector<uint> featureIdxs;
+        /**
+         * Attribute label (ATTL)
+         */
+        vector<uint> codes;
+        /**
+         * Offset of the attribute value (ATVL) in the value pool.
+         */
+        vector<uint> valueOffsets;
+
+        vector<char> valuePool;
+        vector<uint> valueTable;
+        size_t valueCount = 0ul;
+
+        /**
+         * The constructor.
+         */
+        ENCattributeStore() noexcept : featureIdxs(), codes(), valueOffsets(), valuePool(), valueTable() { }
+
+        /**
+         * Gets the number of rows.
+         */
+        inline const size_t size() const noexcept { return codes.size(); }
+
+        /**
+         * Gets the value of a row.
+         * @param idx Between 0 and size()-1.
+         */
+        inline const char *GetValue(const size_t &idx) const noexcept { return valuePool.data() + valueOffsets[idx]; }
+
+        /**
+         * Find the row of an attribute among the rows of a feature.
+         * @return The row, or size() if the feature hasn't this attribute.
+         * @see ENCGeometryPrimitive::GetAttributeOffset()
+         */
+        const size_t Find(const size_t &offset, const size_t &count, const uint &code) const noexcept {
+            for (auto idx = offset; idx < offset + count; ++idx) {
+                if (codes[idx] == code) {
+                    return idx;
+                }
+            }
+
+            return size();
+        }
+
+        /**
+         * Add a row, the feature index is set once the feature is stored.
+         * @param value UTF-8 text, not zero terminated.
+         */
+        void AddAttribute(const uint &code, const char *value, const size_t &valueSize) noexcept {
+            featureIdxs.push_back(ENC_NO_FEATURE_IDX);
+            codes.push_back(code);
+            valueOffsets.push_back(InternValue(value, valueSize));
+        }
+
+        /**
+         * Add the rows of an other store at the end of this one, the values are
+         * interned again into this value pool.
+         */
+        void Append(const ENCattributeStore &store) noexcept {
+            for (auto idx = 0ul; idx < store.size(); ++idx) {
+                auto &&value = store.GetValue(idx);
+
+                featureIdxs.push_back(store.featureIdxs[idx]);
+                codes.push_back(store.codes[idx]);
+                valueOffsets.push_back(InternValue(value, strlen(value)));
+            }
+        }
+
+        /**
+         * Remove all the rows and values and release the memory.
+         */
+        void Clear() noexcept {
+            vector<uint>().swap(featureIdxs);
+            vector<uint>().swap(codes);
+            vector<uint>().swap(valueOffsets);
+            vector<char>().swap(valuePool);
+            vector<uint>().swap(valueTable);
+            valueCount = 0ul;
+        }
+
+    private:
+        uint &FindSlot(const char *value, const size_t &valueSize) noexcept {
+            // FNV-1a, the table is at most half full.
+            uint valueHash = 0x811C9DC5u;
+            for (auto idx = 0ul; idx < valueSize; ++idx) {
+                valueHash = (valueHash ^ static_cast<byte>(value[idx])) * 0x01000193u;
+            }
+
+            const auto &&tableMask = valueTable.size() - 1ul;
+            auto idx = static_cast<size_t>(valueHash) & tableMask;
+
+            while (valueTable[idx]) {
+                auto &&pooledValue = valuePool.data() + valueTable[idx] - 1u;
+                if (!strncmp(pooledValue, value, valueSize) && !pooledValue[valueSize]) {
+                    break;
+                }
+
+                idx = (idx + 1ul) & tableMask;
+            }
+
+            return valueTable[idx];
+        }
+
+        const uint InternValue(const char *value, const size_t &valueSize) noexcept {
+            if ((valueCount + 1ul) * 2ul > valueTable.size()) {
+                vector<uint> pooledOffsets;
+                pooledOffsets.reserve(valueTable.size());
+
+                for (auto &&slot : valueTable) {
+                    if (slot) {
+                        pooledOffsets.push_back(slot);
+                    }
+                }
+
+                valueTable.assign(max(static_cast<size_t>(ENC_STORE_BLOCK_SIZE), valueTable.size() * 2ul), 0u);
+
+                for (auto &&pooledOffset : pooledOffsets) {
+                    auto &&pooledValue = valuePool.data() + pooledOffset - 1u;
+                    FindSlot(pooledValue, strlen(pooledValue)) = pooledOffset;
+                }
+            }
+
+            auto &&slot = FindSlot(value, valueSize);
+            if (!slot) {
+                slot = static_cast<uint>(valuePool.size()) + 1u;
+
+                valuePool.insert(valuePool.end(), value, value + valueSize);
+                valuePool.push_back('\0');
+                ++valueCount;
+            }
+
+            return slot - 1u;
+        }
+    };
     
     /**
      * Data structure code,
@@ -153,6 +470,774 @@ namespace Standards {
         ENC_DSTR_NO = 255u
     };
 
+    /**
+     * The records read by ENCChart::Ingest(), the data set records (DSID, DSPM)
+     * are always read.
+     */
+    enum ENCingestMode : byte {
+        /**
+         * Vector and feature records
+         */
+        ENC_IM_ALL = 0u,
+        /**
+         * Feature records only, the features have no geometry then
+         */
+        ENC_IM_FEATURES,
+        /**
+         * Vector records only
+         */
+        ENC_IM_GEOMETRY
+    };
+
+    /**
+     * The fields, subfields and attributes ENCChart::Ingest() materialises.  A field
+     * left out is never decoded, a subfield left out reads as 0.
+     * The default profile selects everything.
+     */
+    struct ENCingestProfile {
+        /**
+         * The tags of the fields to read, each with the mnemonics of the subfields to
+         * keep, all of them if the list is empty.  Every field is read if the map is
+         * empty.  The record identifier fields (VRID, FRID) and the data set fields
+         * are always read, and RCNM and RCID are always kept.
+         */
+        map<string, vector<string>> fields;
+
+        /**
+         * The attribute labels (ATTL) to keep, all of them if empty.
+         */
+        vector<uint> attributeCodes;
+
+        /**
+         * Check if a field is read.
+         * @param fieldName The tag of the field.
+         */
+        const bool IsFieldSelected(const string &fieldName) const noexcept;
+
+        /**
+         * Check if a subfield of a field that is read is kept.
+         * @param fieldName The tag of the field.
+         * @param subfieldName The mnemonic of the subfield.
+         */
+        const bool IsSubfieldSelected(const string &fieldName, const string &subfieldName) const noexcept;
+
+        /**
+         * Check if an attribute is kept.
+         * @param attributeCode The attribute label (ATTL).
+         */
+        const bool IsAttributeSelected(const uint &attributeCode) const noexcept;
+    };
+
+    /**
+     * The fields and subfields read by ENCChart, resolved once per module.
+     * @see DDFSubfieldHandle
+     */
+    struct ENCsubfieldHandles {
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle DSNM;
+        } DSID;
+
+        struct {
+            DDFSubfieldHandle NALL, AALL, DSTR;
+        } DSSI;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle COMF, SOMF, CSCL;
+        } DSPM;
+
+        /**
+         * The fields below have a fixed layout in S-57 Ed 3.1, isLayoutValid is set
+         * when the DDR of the module matches it.
+         * @see S57Field
+         */
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle RCNM, RCID, RVER, RUIN;
+            bool isLayoutValid = false;
+        } VRID;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle NAME, ORNT, USAG, MASK, TOPI;
+            bool isLayoutValid = false;
+        } VRPT;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle XCOO, YCOO;
+            bool isLayoutValid = false;
+        } SG2D;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle XCOO, YCOO, VE3D;
+            bool isLayoutValid = false;
+        } SG3D;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle PRIM, RCNM, RCID, RVER, RUIN, GRUP, OBJL;
+            bool isLayoutValid = false;
+        } FRID;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle AGEN, FIDN, FIDS;
+            bool isLayoutValid = false;
+        } FOID;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle NAME, ORNT, USAG, MASK;
+            bool isLayoutValid = false;
+        } FSPT;
+
+        /**
+         * The attribute fields, ATVL is text in the lexical level of the data set.
+         */
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle ATTL, ATVL;
+        } ATTF;
+
+        struct {
+            const DDFFieldDefining *field = nullptr;
+            DDFSubfieldHandle ATTL, ATVL;
+        } NATF;
+
+        /**
+         * Resolve the handles on the field definitions of a module.  The fields
+         * and subfields left out by the profile stay unresolved, the field pointer
+         * of a field that isn't read is nullptr.  The fixed layout is only used
+         * for a field whose subfields are all kept.
+         * @param module The module the records are read from.
+         * @param profile The fields and subfields to resolve.
+         */
+        void Resolve(const DDFModule &module, const ENCingestProfile &profile = ENCingestProfile()) noexcept;
+    };
+
+    /**
+     * Vector record identifier field (see 7.7.1.1)
+     */
+    struct ENCfieldVRID {
+        byte RCNM = 0u;
+        uint RCID = 0u;
+        uint RVER = 0u;
+        byte RUIN = 0u;
+    };
+
+    /**
+     * Feature record identifier field (see 7.6.1)
+     */
+    struct ENCfieldFRID {
+        byte RCNM = 0u;
+        uint RCID = 0u;
+        byte PRIM = 0u;
+        byte GRUP = 0u;
+        uint OBJL = 0u;
+        uint RVER = 0u;
+        byte RUIN = 0u;
+    };
+
+    /**
+     * Feature object identifier field (see 7.6.2)
+     */
+    struct ENCfieldFOID {
+        uint AGEN = 0u;
+        uint FIDN = 0u;
+        uint FIDS = 0u;
+    };
+
+    /**
+     * One repeat of the feature record to spatial record pointer field (see 7.6.8),
+     * the NAME is split into it's RCNM and RCID, RCNM is zero if the NAME is missing.
+     */
+    struct ENCfieldFSPT {
+        byte RCNM = 0u;
+        uint RCID = 0u;
+        byte ORNT = 0u;
+        byte USAG = 0u;
+        byte MASK = 0u;
+    };
+
+    /**
+     * One repeat of the vector record pointer field (see 7.7.1.4),
+     * the NAME is split into it's RCNM and RCID, RCNM is zero if the NAME is missing.
+     */
+    struct ENCfieldVRPT {
+        byte RCNM = 0u;
+        uint RCID = 0u;
+        byte ORNT = 0u;
+        byte USAG = 0u;
+        byte TOPI = 0u;
+        byte MASK = 0u;
+    };
+
+    /**
+     * One repeat of the 2-D coordinate field (see 7.7.1.6)
+     */
+    struct ENCfieldSG2D {
+        int YCOO = 0;
+        int XCOO = 0;
+    };
+
+    /**
+     * One repeat of the 3-D coordinate (sounding array) field (see 7.7.1.7)
+     */
+    struct ENCfieldSG3D {
+        int YCOO = 0;
+        int XCOO = 0;
+        int VE3D = 0;
+    };
+
+    /**
+     * Expected format of one subfield of a fixed layout field.
+     */
+    struct ENCsubfieldLayout {
+        const char *name;
+        byte format;
+        DDFbinaryFormat binaryFormat;
+        size_t width;
+    };
+
+    /**
+     * Check a field definition against the layout expected by S57Field.
+     * @param fieldDefining The field definition read from the DDR, may be nullptr.
+     * @param layout The expected subfields, in order.
+     * @param layoutSize The number of expected subfields.
+     * @param isRepeating Whether the subfields are expected to repeat.
+     * @return true if the field definition has exactly this layout.
+     */
+    const bool ENCCheckLayout(const DDFFieldDefining *fieldDefining, const ENCsubfieldLayout *layout, const size_t &layoutSize, const bool isRepeating) noexcept;
+
+    inline const uint ENCReadUInt16(const byte *data) noexcept {
+        return data[0] | (data[1] << 8u);
+    }
+
+    inline const uint ENCReadUInt32(const byte *data) noexcept {
+        return data[0] | (data[1] << 8u) | (data[2] << 16u) | (static_cast<uint>(data[3]) << 24u);
+    }
+
+    inline const int ENCReadInt32(const byte *data) noexcept {
+        return static_cast<int>(ENCReadUInt32(data));
+    }
+
+    /**
+     * Decode the text of an attribute value (ATVL) to UTF-8.
+     * @param value The value as read, up to it's unit terminator.
+     * @param lexicalLevel The lexical level of the field, AALL or NALL.
+     * @param text Receives the UTF-8 text, it's storage is reused.
+     * @see ENClexicalLevel
+     */
+    void ENCDecodeText(const DDFBinaryView &value, const long &lexicalLevel, string &text) noexcept;
+
+    /**
+     * Decoder of a S-57 field with a fixed layout.  Decode(data) reads the values
+     * at compile time offsets, it's only valid once CheckLayout() accepted the
+     * field definition of the module.  Decode(field, idx, handles) is the generic
+     * fallback through the subfield handles.
+     */
+    template<typename T>
+    struct S57Field;
+
+    template<>
+    struct S57Field<ENCfieldVRID> {
+        static constexpr size_t GetWidth() noexcept { return 8u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "RCNM", 'b', DDF_BF_UINT, 1u }, { "RCID", 'b', DDF_BF_UINT, 4u }, { "RVER", 'b', DDF_BF_UINT, 2u }, { "RUIN", 'b', DDF_BF_UINT, 1u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), false);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.VRID.isLayoutValid; }
+
+        static const ENCfieldVRID Decode(const byte *data) noexcept {
+            ENCfieldVRID value;
+
+            value.RCNM = data[0];
+            value.RCID = ENCReadUInt32(data + 1);
+            value.RVER = ENCReadUInt16(data + 5);
+            value.RUIN = data[7];
+
+            return value;
+        }
+
+        static const ENCfieldVRID Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldVRID value;
+
+            value.RCNM = static_cast<byte>(field->GetSubfieldAsLong(handles.VRID.RCNM, idx));
+            value.RCID = static_cast<uint>(field->GetSubfieldAsLong(handles.VRID.RCID, idx));
+            value.RVER = static_cast<uint>(field->GetSubfieldAsLong(handles.VRID.RVER, idx));
+            value.RUIN = static_cast<byte>(field->GetSubfieldAsLong(handles.VRID.RUIN, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldFRID> {
+        static constexpr size_t GetWidth() noexcept { return 12u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "RCNM", 'b', DDF_BF_UINT, 1u }, { "RCID", 'b', DDF_BF_UINT, 4u }, { "PRIM", 'b', DDF_BF_UINT, 1u }, { "GRUP", 'b', DDF_BF_UINT, 1u },
+                { "OBJL", 'b', DDF_BF_UINT, 2u }, { "RVER", 'b', DDF_BF_UINT, 2u }, { "RUIN", 'b', DDF_BF_UINT, 1u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), false);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.FRID.isLayoutValid; }
+
+        static const ENCfieldFRID Decode(const byte *data) noexcept {
+            ENCfieldFRID value;
+
+            value.RCNM = data[0];
+            value.RCID = ENCReadUInt32(data + 1);
+            value.PRIM = data[5];
+            value.GRUP = data[6];
+            value.OBJL = ENCReadUInt16(data + 7);
+            value.RVER = ENCReadUInt16(data + 9);
+            value.RUIN = data[11];
+
+            return value;
+        }
+
+        static const ENCfieldFRID Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldFRID value;
+
+            value.RCNM = static_cast<byte>(field->GetSubfieldAsLong(handles.FRID.RCNM, idx));
+            value.RCID = static_cast<uint>(field->GetSubfieldAsLong(handles.FRID.RCID, idx));
+            value.PRIM = static_cast<byte>(field->GetSubfieldAsLong(handles.FRID.PRIM, idx));
+            value.GRUP = static_cast<byte>(field->GetSubfieldAsLong(handles.FRID.GRUP, idx));
+            value.OBJL = static_cast<uint>(field->GetSubfieldAsLong(handles.FRID.OBJL, idx));
+            value.RVER = static_cast<uint>(field->GetSubfieldAsLong(handles.FRID.RVER, idx));
+            value.RUIN = static_cast<byte>(field->GetSubfieldAsLong(handles.FRID.RUIN, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldFOID> {
+        static constexpr size_t GetWidth() noexcept { return 8u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "AGEN", 'b', DDF_BF_UINT, 2u }, { "FIDN", 'b', DDF_BF_UINT, 4u }, { "FIDS", 'b', DDF_BF_UINT, 2u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), false);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.FOID.isLayoutValid; }
+
+        static const ENCfieldFOID Decode(const byte *data) noexcept {
+            ENCfieldFOID value;
+
+            value.AGEN = ENCReadUInt16(data);
+            value.FIDN = ENCReadUInt32(data + 2);
+            value.FIDS = ENCReadUInt16(data + 6);
+
+            return value;
+        }
+
+        static const ENCfieldFOID Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldFOID value;
+
+            value.AGEN = static_cast<uint>(field->GetSubfieldAsLong(handles.FOID.AGEN, idx));
+            value.FIDN = static_cast<uint>(field->GetSubfieldAsLong(handles.FOID.FIDN, idx));
+            value.FIDS = static_cast<uint>(field->GetSubfieldAsLong(handles.FOID.FIDS, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldFSPT> {
+        static constexpr size_t GetWidth() noexcept { return 8u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "NAME", 'B', DDF_BF_NOT_BINARY, 5u }, { "ORNT", 'b', DDF_BF_UINT, 1u }, { "USAG", 'b', DDF_BF_UINT, 1u }, { "MASK", 'b', DDF_BF_UINT, 1u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), true);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.FSPT.isLayoutValid; }
+
+        static const ENCfieldFSPT Decode(const byte *data) noexcept {
+            ENCfieldFSPT value;
+
+            value.RCNM = data[0];
+            value.RCID = ENCReadUInt32(data + 1);
+            value.ORNT = data[5];
+            value.USAG = data[6];
+            value.MASK = data[7];
+
+            return value;
+        }
+
+        static const ENCfieldFSPT Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldFSPT value;
+            auto &&name = field->GetSubfieldAsBinaryView(handles.FSPT.NAME, idx);
+
+            if (name.size >= 5) {
+                value.RCNM = name[0];
+                value.RCID = ENCReadUInt32(name.data + 1);
+            }
+
+            value.ORNT = static_cast<byte>(field->GetSubfieldAsLong(handles.FSPT.ORNT, idx));
+            value.USAG = static_cast<byte>(field->GetSubfieldAsLong(handles.FSPT.USAG, idx));
+            value.MASK = static_cast<byte>(field->GetSubfieldAsLong(handles.FSPT.MASK, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldVRPT> {
+        static constexpr size_t GetWidth() noexcept { return 9u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "NAME", 'B', DDF_BF_NOT_BINARY, 5u }, { "ORNT", 'b', DDF_BF_UINT, 1u }, { "USAG", 'b', DDF_BF_UINT, 1u },
+                { "TOPI", 'b', DDF_BF_UINT, 1u }, { "MASK", 'b', DDF_BF_UINT, 1u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), true);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.VRPT.isLayoutValid; }
+
+        static const ENCfieldVRPT Decode(const byte *data) noexcept {
+            ENCfieldVRPT value;
+
+            value.RCNM = data[0];
+            value.RCID = ENCReadUInt32(data + 1);
+            value.ORNT = data[5];
+            value.USAG = data[6];
+            value.TOPI = data[7];
+            value.MASK = data[8];
+
+            return value;
+        }
+
+        static const ENCfieldVRPT Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldVRPT value;
+            auto &&name = field->GetSubfieldAsBinaryView(handles.VRPT.NAME, idx);
+
+            if (name.size >= 5) {
+                value.RCNM = name[0];
+                value.RCID = ENCReadUInt32(name.data + 1);
+            }
+
+            value.ORNT = static_cast<byte>(field->GetSubfieldAsLong(handles.VRPT.ORNT, idx));
+            value.USAG = static_cast<byte>(field->GetSubfieldAsLong(handles.VRPT.USAG, idx));
+            value.TOPI = static_cast<byte>(field->GetSubfieldAsLong(handles.VRPT.TOPI, idx));
+            value.MASK = static_cast<byte>(field->GetSubfieldAsLong(handles.VRPT.MASK, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldSG2D> {
+        static constexpr size_t GetWidth() noexcept { return 8u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "YCOO", 'b', DDF_BF_SINT, 4u }, { "XCOO", 'b', DDF_BF_SINT, 4u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), true);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.SG2D.isLayoutValid; }
+
+        static const ENCfieldSG2D Decode(const byte *data) noexcept {
+            ENCfieldSG2D value;
+
+            value.YCOO = ENCReadInt32(data);
+            value.XCOO = ENCReadInt32(data + 4);
+
+            return value;
+        }
+
+        static const ENCfieldSG2D Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldSG2D value;
+
+            value.YCOO = static_cast<int>(field->GetSubfieldAsLong(handles.SG2D.YCOO, idx));
+            value.XCOO = static_cast<int>(field->GetSubfieldAsLong(handles.SG2D.XCOO, idx));
+
+            return value;
+        }
+    };
+
+    template<>
+    struct S57Field<ENCfieldSG3D> {
+        static constexpr size_t GetWidth() noexcept { return 12u; }
+
+        static const bool CheckLayout(const DDFFieldDefining *fieldDefining) noexcept {
+            static const ENCsubfieldLayout layout[] = {
+                { "YCOO", 'b', DDF_BF_SINT, 4u }, { "XCOO", 'b', DDF_BF_SINT, 4u }, { "VE3D", 'b', DDF_BF_SINT, 4u }
+            };
+
+            return ENCCheckLayout(fieldDefining, layout, sizeof(layout) / sizeof(*layout), true);
+        }
+
+        static const bool IsLayoutValid(const ENCsubfieldHandles &handles) noexcept { return handles.SG3D.isLayoutValid; }
+
+        static const ENCfieldSG3D Decode(const byte *data) noexcept {
+            ENCfieldSG3D value;
+
+            value.YCOO = ENCReadInt32(data);
+            value.XCOO = ENCReadInt32(data + 4);
+            value.VE3D = ENCReadInt32(data + 8);
+
+            return value;
+        }
+
+        static const ENCfieldSG3D Decode(const DDFField *field, const ulong &idx, const ENCsubfieldHandles &handles) noexcept {
+            ENCfieldSG3D value;
+
+            value.YCOO = static_cast<int>(field->GetSubfieldAsLong(handles.SG3D.YCOO, idx));
+            value.XCOO = static_cast<int>(field->GetSubfieldAsLong(handles.SG3D.XCOO, idx));
+            value.VE3D = static_cast<int>(field->GetSubfieldAsLong(handles.SG3D.VE3D, idx));
+
+            return value;
+        }
+    };
+
+    /**
+     * Slot of the record identifier table of an ENCrecordStore.
+     */
+    struct ENCrecordSlot {
+        ulong RCID = 0ul;
+        /**
+         * Index of the object plus one, 0 for an empty slot.
+         */
+        size_t objectIdx = 0ul;
+    };
+
+    /**
+     * The objects read from one kind of record of a chart, e.g. the edges.  They are
+     * built in place in blocks of ENC_STORE_BLOCK_SIZE objects and never move, so the
+     * objects of a cell lie next to each other in file order.  The record identifiers
+     * of a cell are small and dense, an open addressing table maps one to it's object
+     * in constant time.
+     */
+    template<typename T>
+    class ENCrecordStore {
+        vector<unique_ptr<byte[]>> blocks;
+        size_t blockUsed = ENC_STORE_BLOCK_SIZE;
+
+        vector<T*> objects;
+        vector<ENCrecordSlot> slotTable;
+
+        /**
+         * Changed by every Insert(), Merge() and Clear(), an object may be gone since.
+         */
+        ulong generation = 0ul;
+
+    public:
+        /**
+         * The constructor.
+         */
+        ENCrecordStore() noexcept : blocks(), objects(), slotTable() { }
+
+        /**
+         * Gets the generation of the objects, views on the store are stale once it changes.
+         * @see ENCrecordView
+         */
+        inline const ulong &GetGeneration() const noexcept { return generation; }
+
+        /**
+         * Build an object in the next free place of the last block.  It belongs to
+         * the store but can't be found before Insert().
+         * @param args The arguments of the constructor of the object.
+         */
+        template<typename... Args>
+        T *Construct(Args&&... args) noexcept {
+            if (blockUsed == ENC_STORE_BLOCK_SIZE) {
+                blocks.emplace_back(new byte[sizeof(T) * ENC_STORE_BLOCK_SIZE]);
+                blockUsed = 0ul;
+            }
+
+            return new (blocks.back().get() + sizeof(T) * blockUsed++) T(forward<Args>(args)...);
+        }
+
+        /**
+         * Destroy the object built by the last Construct(), it's place is reused.
+         */
+        void Discard(T *object) noexcept {
+            object->~T();
+
+            if (blockUsed && reinterpret_cast<byte*>(object) == blocks.back().get() + sizeof(T) * (blockUsed - 1ul)) {
+                --blockUsed;
+            }
+        }
+
+        /**
+         * Make an object built by Construct() findable by it's record identifier,
+         * an object with the same record identifier is destroyed and replaced.
+         */
+        void Insert(const ulong &RCID, T *object) noexcept {
+            ++generation;
+
+            if ((objects.size() + 1ul) * 2ul > slotTable.size()) {
+                Rehash(max(static_cast<size_t>(ENC_STORE_BLOCK_SIZE), slotTable.size() * 2ul));
+            }
+
+            auto &&slot = FindSlot(RCID);
+
+            if (slot.objectIdx) {
+                objects[slot.objectIdx - 1ul]->~T();
+                objects[slot.objectIdx - 1ul] = object;
+
+                return;
+            }
+
+            objects.push_back(object);
+
+            slot.RCID = RCID;
+            slot.objectIdx = objects.size();
+        }
+
+        /**
+         * Fetch the object of a record identifier.
+         * @return The object, or nullptr if there isn't any.
+         */
+        T *Find(const ulong &RCID) const noexcept {
+            if (slotTable.empty()) {
+                return nullptr;
+            }
+
+            auto &&slot = const_cast<ENCrecordStore*>(this)->FindSlot(RCID);
+
+            return slot.objectIdx ? objects[slot.objectIdx - 1ul] : nullptr;
+        }
+
+        /**
+         * Move the objects of another store into this one, without moving them in
+         * memory.  An object with the same record identifier is replaced.
+         */
+        void Merge(ENCrecordStore &otherStore) noexcept {
+            ++generation;
+
+            for (auto &&block : otherStore.blocks) {
+                blocks.push_back(move(block));
+            }
+
+            if (!otherStore.blocks.empty()) {
+                blockUsed = otherStore.blockUsed;
+            }
+
+            for (auto &&object : otherStore.objects) {
+                Insert(object->GetRCID(), object);
+            }
+
+            otherStore.blocks.clear();
+            otherStore.objects.clear();
+            otherStore.slotTable.clear();
+            otherStore.blockUsed = ENC_STORE_BLOCK_SIZE;
+            ++otherStore.generation;
+        }
+
+        /**
+         * Destroy all the objects and release the blocks.
+         */
+        void Clear() noexcept {
+            for (auto &&object : objects) {
+                object->~T();
+            }
+
+            ++generation;
+
+            blocks.clear();
+            objects.clear();
+            slotTable.clear();
+            blockUsed = ENC_STORE_BLOCK_SIZE;
+        }
+
+        /**
+         * Gets the number of objects.
+         */
+        const size_t size() const noexcept { return objects.size(); }
+
+        /**
+         * Check if there isn't any object.
+         */
+        const bool empty() const noexcept { return objects.empty(); }
+
+        /**
+         * Gets an object by it's position in file order.
+         * @param idx Between 0 and size()-1.
+         */
+        const T &operator[] (const size_t &idx) const noexcept { return *objects[idx]; }
+
+        /**
+         * Iterate the objects in file order.
+         */
+        typename vector<T*>::const_iterator begin() const noexcept { return objects.begin(); }
+        typename vector<T*>::const_iterator end() const noexcept { return objects.end(); }
+
+        /**
+         * The destructor.
+         */
+        ~ENCrecordStore() noexcept { Clear(); }
+
+        /**
+         * Delete standart realization
+         */
+        ENCrecordStore(const ENCrecordStore&) = delete;
+        ENCrecordStore(const ENCrecordStore&&) = delete;
+        ENCrecordStore &operator = (const ENCrecordStore&) = delete;
+        ENCrecordStore &operator = (const ENCrecordStore&&) = delete;
+
+    private:
+        ENCrecordSlot &FindSlot(const ulong &RCID) noexcept {
+            // Consecutive identifiers land in distinct slots, the table is at most half full.
+            const auto &&tableMask = slotTable.size() - 1ul;
+            auto idx = static_cast<size_t>(RCID * 0x9E3779B1ul) & tableMask;
+
+            while (slotTable[idx].objectIdx && slotTable[idx].RCID != RCID) {
+                idx = (idx + 1ul) & tableMask;
+            }
+
+            return slotTable[idx];
+        }
+
+        void Rehash(const size_t &tableSize) noexcept {
+            slotTable.assign(tableSize, ENCrecordSlot());
+
+            for (auto idx = 0ul; idx < objects.size(); ++idx) {
+                auto &&slot = FindSlot(objects[idx]->GetRCID());
+
+                slot.RCID = objects[idx]->GetRCID();
+                slot.objectIdx = idx + 1ul;
+            }
+        }
+    };
+
+    /**
+     * A map by record identifier on the objects of a ENCrecordStore, and the
+     * generation of the store it was built from.
+     */
+    template<typename T>
+    struct ENCrecordView {
+        map<ulong, T*> objects;
+        ulong generation = 0ul;
+
+        ENCrecordView() noexcept : objects() { }
+    };
+
 	class ENCChart {
         /**
          * Data structure, see 3.1 and part 2 Theoretical Data Model
@@ -172,15 +1257,15 @@ namespace Standards {
             
         /**
          * Floating-point to integer multiplication factor
-         * for coordinate values (see 3.2.1)
+         * for coordinate values (see 3.2.1), 1 without a DSPM record
          */
-        double COMF = 0.0;
+        double COMF = 1.0;
 
         /**
          * Floating point to integer multiplication factor
-         * for 3-D (sounding) values (see 3.3)
+         * for 3-D (sounding) values (see 3.3), 1 without a DSPM record
          */
-        double SOMF = 0.0;
+        double SOMF = 1.0;
 
         /**
          * The modulus of the compilation scale.
@@ -199,32 +1284,98 @@ namespace Standards {
         DDFModule* module = nullptr;
 
         ENCboundingBox boundingRegion = ENCboundingBox();
+        ENCcoordinatePool vertexPool = ENCcoordinatePool();
+        ENCcoordinatePool soundingPool = ENCcoordinatePool();
+        ENCcoordinateStorage coordinateStorage = ENC_CS_SCALED;
+        ENCattributeStore attributes = ENCattributeStore();
+        ENCsubfieldHandles handles = ENCsubfieldHandles();
+        ENCingestProfile profile = ENCingestProfile();
 
         const string fileName;
 
         //FeatureMap faces;
-        map<ulong, ENCEdgeGeometry*> edges;
-        map<ulong, ENCGeometryPrimitive*> features;
-        map<ulong, ENCPointGeometry*> isolatedNodes;
-        map<ulong, ENCPointGeometry*> connectedNodes;
+        ENCrecordStore<ENCEdgeGeometry> edges;
+        ENCrecordStore<ENCGeometryPrimitive> features;
+        ENCrecordStore<ENCPointGeometry> isolatedNodes;
+        ENCrecordStore<ENCPointGeometry> connectedNodes;
+
+        /**
+         * Map views on the stores for GetEdges() and the like, built on first use.
+         */
+        mutable ENCrecordView<ENCEdgeGeometry> edgeView;
+        mutable ENCrecordView<ENCGeometryPrimitive> featureView;
+        mutable ENCrecordView<ENCPointGeometry> isolatedNodeView;
+        mutable ENCrecordView<ENCPointGeometry> connectedNodeView;
+
+        /**
+         * Repeats of the current record, reused from one record to the next.
+         */
+        vector<ENCfieldSG2D> coordinates;
+        vector<ENCfieldSG3D> soundings;
+        vector<ENCfieldVRPT> vectorPointers;
+        vector<ENCfieldFSPT> spatialPointers;
+        string attributeText;
 
     public:
         /**
          * The constructor
          * @param path The path to the S57 file
          */
-        ENCChart(const string path) noexcept : fileName(path), edges()/*, faces()*/, features(), isolatedNodes(), connectedNodes() { }
+        ENCChart(const string path) noexcept : fileName(path), edges()/*, faces()*/, features(), isolatedNodes(), connectedNodes(),
+            edgeView(), featureView(), isolatedNodeView(), connectedNodeView(), coordinates(), soundings(), vectorPointers(), spatialPointers(), attributeText() { }
 
         /**
          * Open a S57 file (ENC) for reading.
+         * @param openMode The way the file contents are accessed.
          * @return false if the open fails.
+         * @see DDFopenMode
          */
-        const bool Open() noexcept;
+        const bool Open(const DDFopenMode openMode = DDF_OM_BUFFERED) noexcept;
+
+        /**
+         * Open a S57 stream (ENC) for reading, e.g. a pipe or the standard input.
+         * The stream is read forward only through a bounded buffer.
+         * @param inputStream The stream to read from, it must outlive the chart or Close().
+         * @return false if the open fails.
+         */
+        const bool Open(istream &inputStream) noexcept;
 
         /**
          * Read all the records into memory, adding to the appropriate indexes.
+         * With more than one thread the records are decoded in parallel,
+         * a chart opened with DDF_OM_STREAMED is always read on the calling thread.
+         * @param threadCount The number of decoding threads, 0 to use one per hardware thread.
+         * @param ingestMode The records to read, the others are skipped without being decoded.
+         * Problems with the records are reported to DDFDiagnostics.
+         * @see ENCingestMode, DDFDiagnostics
+         */
+        const bool Ingest(const uint threadCount = 1u, const ENCingestMode ingestMode = ENC_IM_ALL) noexcept;
+
+        /**
+         * Select how Ingest() stores the coordinates of the vertex and sounding pools.
+         * @param coordinateStorage The storage, it applies to the next Ingest().
+         * @see ENCcoordinateStorage
          */
-        const bool Ingest() noexcept;
+        void SetCoordinateStorage(const ENCcoordinateStorage coordinateStorage) noexcept;
+
+        /**
+         * Fill the scaled coordinates of the pools ingested with ENC_CS_RAW.
+         * @see ENCcoordinatePool::Scale()
+         */
+        void ScaleCoordinates() noexcept;
+
+        /**
+         * Select the fields, subfields and attributes materialised by Ingest().
+         * @param ingestProfile The profile, it may be set before or after Open().
+         * @see ENCingestProfile
+         */
+        void SetIngestProfile(const ENCingestProfile &ingestProfile) noexcept;
+
+        /**
+         * Gets the fields, subfields and attributes materialised by Ingest().
+         * @see ENCingestProfile
+         */
+        inline const ENCingestProfile &GetIngestProfile() const noexcept { return profile; }
 
         /**
          * Read all the recods into standart output
@@ -237,28 +1388,81 @@ namespace Standards {
         const bool FindAndUpplyUpdates() noexcept;
 
         /**
-         * Gets the connected nodes map
-         * @see ENCPointGeometry
+         * Gets the connected nodes map, a view built on the first call after Ingest().
+         * @see ENCPointGeometry, GetConnectedNodeStore()
          */
-        inline const map<ulong, ENCPointGeometry*> &GetConnectedNodes() const noexcept { return connectedNodes; }
+        const map<ulong, ENCPointGeometry*> &GetConnectedNodes() const noexcept;
         
         /**
-         * Gets the isolated nodes map
-         * @see ENCPointGeometry
+         * Gets the isolated nodes map, a view built on the first call after Ingest().
+         * @see ENCPointGeometry, GetIsolatedNodeStore()
          */
-        inline const map<ulong, ENCPointGeometry*> &GetIsolatedNodes() const noexcept { return isolatedNodes; }
+        const map<ulong, ENCPointGeometry*> &GetIsolatedNodes() const noexcept;
         
         /**
-         * Gets the edge map
-         * @see ENCEdgeGeometry
+         * Gets the edge map, a view built on the first call after Ingest().
+         * @see ENCEdgeGeometry, GetEdgeStore()
          */
-        inline const map<ulong, ENCEdgeGeometry*> &GetEdges() const noexcept { return edges; }
+        const map<ulong, ENCEdgeGeometry*> &GetEdges() const noexcept;
         
         /**
-         * Gets the feature map
-         * @see ENCGeometryPrimitive
+         * Gets the feature map, a view built on the first call after Ingest().
+         * @see ENCGeometryPrimitive, GetFeatureStore()
+         */
+        const map<ulong, ENCGeometryPrimitive*> &GetFeatures() const noexcept;
+
+        /**
+         * Gets the connected nodes in file order, with constant time lookup by RCID.
+         * @see ENCrecordStore
+         */
+        inline const ENCrecordStore<ENCPointGeometry> &GetConnectedNodeStore() const noexcept { return connectedNodes; }
+
+        /**
+         * Gets the isolated nodes in file order, with constant time lookup by RCID.
+         * @see ENCrecordStore
          */
-        inline const map<ulong, ENCGeometryPrimitive*> &GetFeatures() const noexcept { return features; }
+        inline const ENCrecordStore<ENCPointGeometry> &GetIsolatedNodeStore() const noexcept { return isolatedNodes; }
+
+        /**
+         * Gets the edges in file order, with constant time lookup by RCID.
+         * @see ENCrecordStore
+         */
+        inline const ENCrecordStore<ENCEdgeGeometry> &GetEdgeStore() const noexcept { return edges; }
+
+        /**
+         * Gets the features in file order, with constant time lookup by RCID.
+         * @see ENCrecordStore
+         */
+        inline const ENCrecordStore<ENCGeometryPrimitive> &GetFeatureStore() const noexcept { return features; }
+
+        /**
+         * Gets the vertices of all the edges and 2-D nodes (SG2D), an edge or a
+         * node refers to it's own by offset and count.
+         * @see ENCEdgeGeometry::GetPointOffset(), ENCPointGeometry::GetPointOffset()
+         */
+        inline const ENCcoordinatePool &GetVertexPool() const noexcept { return vertexPool; }
+
+        /**
+         * Gets the soundings (SG3D) of all the nodes, a node refers to
+         * it's own by offset and count.
+         * @see ENCPointGeometry::GetSoundingOffset()
+         */
+        inline const ENCcoordinatePool &GetSoundingPool() const noexcept { return soundingPool; }
+
+        /**
+         * Gets the attributes (ATTF, NATF) of all the features, a feature refers
+         * to it's own by offset and count.
+         * @see ENCGeometryPrimitive::GetAttributeOffset()
+         */
+        inline const ENCattributeStore &GetAttributes() const noexcept { return attributes; }
+
+        /**
+         * Gets the value of an attribute of a feature.
+         * @param feature A feature of this chart.
+         * @param attributeCode The attribute label (ATTL).
+         * @return The UTF-8 value, or nullptr if the feature hasn't this attribute.
+         */
+        const char *GetAttributeValue(const ENCGeometryPrimitive *feature, const uint &attributeCode) const noexcept;
 
         /**
          * Gets the bounding region for this chart
@@ -285,9 +1489,76 @@ namespace Standards {
         ENCChart &operator = (const ENCChart&&) = delete;
 
     private:
+        const bool CheckModule() noexcept;
+        void IngestRecord(const DDFRecord *record) noexcept;
+        void IngestParallel(const uint workerCount, const DDFRecordFilter &recordFilter) noexcept;
+        void PreparePools() noexcept;
+        void IndexAttributes() noexcept;
+        void ReadAttributes(const DDFField *field, const DDFSubfieldHandle &ATTL, const DDFSubfieldHandle &ATVL, const long &lexicalLevel) noexcept;
         const bool ApplyUpdates(DDFModule &updModule, byte &updNumber) noexcept;
         const bool ReadVector(const DDFRecord *&record, const DDFField *&fieldVRID) noexcept;
         const bool ReadFeature(const DDFRecord *&record, const DDFField *&fieldFRID) noexcept;
+
+        /**
+         * Decode the first repeat of a fixed layout field, straight from the record
+         * bytes when the DDR matched the layout, through the subfield handles otherwise.
+         * @see S57Field
+         */
+        template<typename T>
+        const T DecodeField(const DDFField *field) const noexcept {
+            if (S57Field<T>::IsLayoutValid(handles) && field->GetDataSize() >= S57Field<T>::GetWidth()) {
+                return S57Field<T>::Decode(field->GetBinaryData());
+            }
+
+            return S57Field<T>::Decode(field, 0ul, handles);
+        }
+
+        /**
+         * Decode all the repeats of a fixed layout field.
+         * @param values Receives one value per repeat, it's storage is reused.
+         * @return The number of repeats.
+         * @see S57Field
+         */
+        template<typename T>
+        const size_t DecodeRepeats(const DDFField *field, vector<T> &values) const noexcept {
+            if (S57Field<T>::IsLayoutValid(handles)) {
+                auto data = field->GetBinaryData();
+                values.resize(field->GetDataSize() / S57Field<T>::GetWidth());
+
+                for (auto &&value : values) {
+                    value = S57Field<T>::Decode(data);
+                    data += S57Field<T>::GetWidth();
+                }
+            } else {
+                values.resize(field->GetRepeatCount());
+
+                for (auto idx = 0ul; idx < values.size(); ++idx) {
+                    values[idx] = S57Field<T>::Decode(field, idx, handles);
+                }
+            }
+
+            return values.size();
+        }
+
+        /**
+         * Fill a map view with the objects of a store, unless it was built from the
+         * same generation of the store.
+         */
+        template<typename T>
+        static const map<ulong, T*> &BuildView(const ENCrecordStore<T> &objects, ENCrecordView<T> &objectView) noexcept {
+            if (objectView.generation != objects.GetGeneration()) {
+                objectView.objects.clear();
+
+                // The objects are in file order, which needn't be the order of their record identifiers.
+                for (auto &&object : objects) {
+                    objectView.objects.emplace(object->GetRCID(), object);
+                }
+
+                objectView.generation = objects.GetGeneration();
+            }
+
+            return objectView.objects;
+        }
     };
 
     /**
@@ -459,6 +1730,12 @@ namespace Standards {
     class ENCPointGeometry final : public ENCFeature {
         Vector3 point = Vector3();
 
+        size_t pointOffset = 0ul;
+        size_t pointCount = 0ul;
+
+        size_t soundingOffset = 0ul;
+        size_t soundingCount = 0ul;
+
     public:
         /**
          * The constructor
@@ -466,10 +1743,32 @@ namespace Standards {
         ENCPointGeometry(const ulong &rcnm, const ulong &rcid, const ulong &rver, const ulong &ruin) noexcept : ENCFeature(rcnm, rcid, rver, ruin) { }
 
         /**
-         * Gets the point reference
+         * Gets the point reference, the first sounding of a node with several.
          */
         inline const Vector3 &GetPointRef() const noexcept { return point; }
 
+        /**
+         * Gets the index of the coordinate (SG2D) of the node in the vertex pool.
+         * @see ENCChart::GetVertexPool()
+         */
+        inline const size_t &GetPointOffset() const noexcept { return pointOffset; }
+
+        /**
+         * Gets the number of coordinates (SG2D) of the node, 0 for a 3-D node.
+         */
+        inline const size_t &GetPointCount() const noexcept { return pointCount; }
+
+        /**
+         * Gets the index of the first sounding of the node in the sounding pool.
+         * @see ENCChart::GetSoundingPool()
+         */
+        inline const size_t &GetSoundingOffset() const noexcept { return soundingOffset; }
+
+        /**
+         * Gets the number of soundings (SG3D) of the node, 0 for a 2-D node.
+         */
+        inline const size_t &GetSoundingCount() const noexcept { return soundingCount; }
+
         /**
          * The destructor
          */
@@ -599,12 +1898,13 @@ namespace Standards {
         ENCvectorRecordPointer beginNode = ENCvectorRecordPointer();
         ENCvectorRecordPointer endNode = ENCvectorRecordPointer();
 
-        vector<Vector3> points;
+        size_t pointOffset = 0ul;
+        size_t pointCount = 0ul;
     public:
         /**
          * The constructor.
          */
-        ENCEdgeGeometry(const ulong &rcnm, const ulong &rcid, const ulong &rver, const ulong &ruin) noexcept : ENCFeature(rcnm, rcid, rver, ruin), points() { }
+        ENCEdgeGeometry(const ulong &rcnm, const ulong &rcid, const ulong &rver, const ulong &ruin) noexcept : ENCFeature(rcnm, rcid, rver, ruin) { }
 
         /**
          * Gets reference for the begibing node.
@@ -619,9 +1919,15 @@ namespace Standards {
         inline const ENCvectorRecordPointer &GetEndNode() const noexcept { return endNode; }
 
         /**
-         * Gets reference for the points array
+         * Gets the index of the first vertex of the edge in the vertex pool.
+         * @see ENCChart::GetVertexPool()
+         */
+        inline const size_t &GetPointOffset() const noexcept { return pointOffset; }
+
+        /**
+         * Gets the number of vertices of the edge.
          */
-        inline const vector<Vector3>& GetPointsRef() const noexcept { return points; }
+        inline const size_t &GetPointCount() const noexcept { return pointCount; }
 
         /**
          * The destructor.
@@ -1534,6 +2840,9 @@ namespace Standards {
     class ENCGeometryPrimitive final : public ENCPrimitive {
         vector<ENCspatialRecordPointer> FSPTObjects;
 
+        size_t attributeOffset = 0ul;
+        size_t attributeCount = 0ul;
+
     public:
         /**
          * The constructor
@@ -1546,6 +2855,17 @@ namespace Standards {
          */
         inline const vector<ENCspatialRecordPointer> &GetFSPTObjects() const noexcept { return FSPTObjects; }
 
+        /**
+         * Gets the index of the first attribute of the feature in the attribute store.
+         * @see ENCChart::GetAttributes()
+         */
+        inline const size_t &GetAttributeOffset() const noexcept { return attributeOffset; }
+
+        /**
+         * Gets the number of attributes (ATTF and NATF) of the feature.
+         */
+        inline const size_t &GetAttributeCount() const noexcept { return attributeCount; }
+
         /**
          * The destructor
          */
@@ -12,10 +12,17 @@
 #define DDF_FIELD_TERMINATOR    0x1E
 #define DDF_UNIT_TERMINATOR     0x1F
 #define DDF_LEADER_SIZE         0x18
+#define DDF_STREAM_BUFFER_SIZE  0x10000
+#define DDF_INDEX_TAG_SIZE      0x04
+#define DDF_DDR_CACHE_SIZE      0x10
+#define DDF_DIAGNOSTIC_RING_SIZE 0x100
 
 #include <map>
 #include <string>
 #include <vector>
+#include <initializer_list>
+#include <memory>
+#include <istream>
 #include <sstream>
 #include <algorithm>
 
@@ -23,6 +30,11 @@ typedef unsigned int uint;
 typedef unsigned char byte;
 typedef unsigned long ulong;
 
+/**
+ * Field tag packed into an integer, see Standards::DDFPackTag().
+ */
+typedef unsigned int DDFTag;
+
 using namespace std;
 
 namespace Standards {
@@ -31,6 +43,7 @@ namespace Standards {
      */
     class DDFField;
     class DDFRecord;
+    class DDFReader;
     class DDFFieldDefining;
     class DDFSubfieldDefining;
 
@@ -48,6 +61,16 @@ namespace Standards {
      */
     int DDFScanInt(const char *strSource, byte byteRead = 32u) noexcept;
 
+    /**
+     * Parse a fixed width unsigned decimal number, as found in leaders and directories.
+     * Spaces are allowed around the digits, anything else is an error.
+     * @param strSource source string.
+     * @param byteRead number of bytes to read.
+     * @param value output variable, receives the number.
+     * @return false if the bytes aren't a number, value is then left untouched.
+     */
+    const bool DDFParseInt(const char *strSource, const byte byteRead, size_t *value) noexcept;
+
     /**
      * Clone string
      * @param strSource source string.
@@ -56,6 +79,16 @@ namespace Standards {
      */
     char* DDFCloneString(const char *strSource, const size_t &byteClone) noexcept;
 
+    /**
+     * Pack a field tag of up to DDF_INDEX_TAG_SIZE characters into an integer,
+     * first character in the lowest byte.  Tags compare equal if and only if
+     * their packed values are equal.
+     * @param tagName the tag characters, not necessarily zero terminated.
+     * @param tagLenght number of characters in the tag.
+     * @return the packed tag, or 0 if the tag is empty or too long to be packed.
+     */
+    const DDFTag DDFPackTag(const char *tagName, const size_t &tagLenght) noexcept;
+
     /**
      * Correct string
      * @param strSource source string
@@ -76,15 +109,381 @@ namespace Standards {
      */
     char* DDFFetchVariable(const char* strRecord, size_t strLenght, size_t* consumedChar, const char delimCharOne = DDF_UNIT_TERMINATOR, const char delimCharSecond = DDF_FIELD_TERMINATOR) noexcept;
 
+    /**
+     * Find the first occurrence of either of two delimiters.  Uses an AVX2 or SSE2
+     * kernel when the processor supports it, picked once at runtime.
+     * @param sourceData the data to scan.
+     * @param dataSize the number of bytes to scan.
+     * @param delimCharOne first delim char. Default value is DDF_UNIT_TERMINATOR.
+     * @param delimCharSecond second delim char. Default value is DDF_FIELD_TERMINATOR.
+     * @return the index of the first delimiter, or dataSize if there isn't any.
+     */
+    size_t DDFFindDelimiter(const byte* sourceData, const size_t &dataSize, const byte delimCharOne = DDF_UNIT_TERMINATOR, const byte delimCharSecond = DDF_FIELD_TERMINATOR) noexcept;
+
+    /**
+     * Map a whole file into memory for reading.
+     * @param fileName The name of the file to map.
+     * @param fileSize output variable, contain the size of the mapped file in bytes.
+     * @return pointer to the read-only mapping, or nullptr if the file can't be mapped.
+     * @see DDFUnmapFile()
+     */
+    const byte* DDFMapFile(const string &fileName, size_t *fileSize) noexcept;
+
+    /**
+     * Release a mapping created by DDFMapFile().
+     * @param fileData pointer to the mapping.
+     * @param fileSize the size of the mapping in bytes.
+     */
+    void DDFUnmapFile(const byte *fileData, const size_t &fileSize) noexcept;
+
+    /**
+     * What a diagnostic reported through DDFDiagnostics is about.
+     */
+    typedef enum : byte {
+        /**
+         * A file, stream or record index sidecar can't be opened, read or written.
+         */
+        DDF_DC_FILE = 0u,
+        /**
+         * A field definition of the DDR is invalid or defined more than once.
+         */
+        DDF_DC_DEFINITION,
+        /**
+         * The leader, directory or size of a data record is invalid.
+         */
+        DDF_DC_RECORD,
+        /**
+         * A subfield value is short or it's format isn't recognised.
+         */
+        DDF_DC_SUBFIELD,
+        /**
+         * The application found a record whose contents it can't use.
+         */
+        DDF_DC_CONTENT,
+        /**
+         * The application skipped a record it doesn't handle.
+         */
+        DDF_DC_SKIPPED,
+        DDF_DC_COUNT
+    } DDFdiagnosticCategory;
+
+    /**
+     * One message drained from DDFDiagnostics.
+     */
+    struct DDFDiagnostic {
+        DDFdiagnosticCategory category = DDF_DC_FILE;
+        string message;
+    };
+
+    /**
+     * Process wide sink of the warnings of the library, which never writes to the
+     * standard output itself.  Every report bumps an atomic counter of it's category.
+     * Messages are off by default, once enabled at most a given number of them per
+     * second go to a ring of DDF_DIAGNOSTIC_RING_SIZE entries that the application
+     * drains, the oldest are overwritten.  Thread safe.
+     */
+    class DDFDiagnostics {
+    public:
+        /**
+         * Count a diagnostic.
+         * @param category What the diagnostic is about.
+         * @return true if a message is wanted for it, it is then passed to Post().
+         */
+        static const bool Report(const DDFdiagnosticCategory category) noexcept;
+
+        /**
+         * Store the message of a diagnostic Report() asked for.
+         * @param category What the diagnostic is about.
+         * @param message The text of the diagnostic.
+         */
+        static void Post(const DDFdiagnosticCategory category, const string &message) noexcept;
+
+        /**
+         * Move the stored messages, oldest first, to the end of a list.
+         * @param messages Receives the messages.
+         * @return The number of messages moved.
+         */
+        static const size_t Drain(vector<DDFDiagnostic> &messages) noexcept;
+
+        /**
+         * Gets the number of diagnostics of a category reported since the last Reset().
+         */
+        static const size_t GetCount(const DDFdiagnosticCategory category) noexcept;
+
+        /**
+         * Gets the number of messages lost to the rate limit or overwritten in the ring.
+         */
+        static const size_t GetDroppedCount() noexcept;
+
+        /**
+         * Set how many messages are stored per second.
+         * @param messageRate The number of messages, 0 (the default) stores none.
+         */
+        static void SetMessageRate(const size_t messageRate) noexcept;
+
+        /**
+         * Clear the counters and the stored messages.
+         */
+        static void Reset() noexcept;
+    };
+
+    /**
+     * The way DDFModule accesses the file contents.
+     */
+    typedef enum : byte {
+        /**
+         * The file is read into a heap buffer owned by the module.
+         */
+        DDF_OM_BUFFERED = 0u,
+        /**
+         * The file is mapped read-only, records point straight into the mapping.
+         */
+        DDF_OM_MAPPED,
+        /**
+         * The file is read through a fixed-size refillable buffer, records are
+         * returned as soon as their bytes arrive and no seeking is needed.
+         */
+        DDF_OM_STREAMED
+    } DDFopenMode;
+
+    /**
+     * State of a directory entry of a record whose directory is decoded lazily.
+     * @see DDFModule::SetLazyDirectory()
+     */
+    typedef enum : byte {
+        DDF_DES_PENDING = 0u,
+        DDF_DES_DECODED,
+        DDF_DES_CORRUPT
+    } DDFdirectoryEntryState;
+
+    /**
+     * Location of one data record (DR) in the file.
+     * @see DDFModule::BuildIndex()
+     */
+    struct DDFRecordIndexEntry {
+        /**
+         * Offset of the record leader from the start of the file.
+         */
+        size_t recordOffset = 0ul;
+        /**
+         * Length of the record including the leader.
+         */
+        size_t recordLenght = 0ul;
+        /**
+         * Tag of the first data field of the record, the record identifier
+         * field (0001) is skipped.  Padded with zeros.
+         */
+        char fieldTag[DDF_INDEX_TAG_SIZE] = { '\0', '\0', '\0', '\0' };
+    };
+
+    /**
+     * Selects data records by the tags in their raw directory, so records that
+     * don't match are skipped before any field is built.
+     * @see DDFModule::ReadRecord(const DDFRecordFilter&)
+     */
+    struct DDFRecordFilter {
+        /**
+         * Packed tags the first data field of a record may have, the record
+         * identifier field (0001) is skipped.  Any tag matches if empty.
+         */
+        vector<DDFTag> recordTags;
+        /**
+         * Packed tags of the fields a record must all have.
+         */
+        vector<DDFTag> requiredTags;
+
+        /**
+         * The constructor.
+         * @param recordTags The tags the first data field may have, e.g. { "VRID" }.
+         * @param requiredTags The tags of the fields a record must have, e.g. { "SG2D" }.
+         */
+        DDFRecordFilter(const initializer_list<string> &recordTags = {}, const initializer_list<string> &requiredTags = {}) noexcept;
+
+        /**
+         * Check if a record with this tag as first data field is selected.
+         * @param fieldTag The packed tag of the first data field.
+         */
+        const bool IsRecordTag(const DDFTag &fieldTag) const noexcept;
+
+        /**
+         * Check the raw directory of a record against the filter.
+         * @param recordData The record, starting with it's leader.
+         * @param recordLenght The lenght of the record.
+         * @return true if the record is selected.  A record whose leader or
+         * directory can't be read is selected too, so that the error is reported
+         * when it's parsed.
+         */
+        const bool Match(const byte *recordData, const size_t &recordLenght) const noexcept;
+    };
+
+    /**
+     * A non-owning view on a run of values inside record data.  It doesn't copy
+     * nor allocate, and is valid only as long as the data it points into.
+     */
+    template<typename T>
+    struct DDFSpan {
+        const T *data = nullptr;
+        size_t size = 0ul;
+
+        DDFSpan() noexcept = default;
+        DDFSpan(const T *data, const size_t size) noexcept : data(data), size(size) { }
+
+        const bool empty() const noexcept { return !size; }
+        const T *begin() const noexcept { return data; }
+        const T *end() const noexcept { return data + size; }
+        const T &operator[] (const size_t &idx) const noexcept { return data[idx]; }
+    };
+
+    /**
+     * A subfield value as text, not zero terminated.
+     */
+    typedef DDFSpan<char> DDFStringView;
+
+    /**
+     * A subfield value as raw bytes.
+     */
+    typedef DDFSpan<byte> DDFBinaryView;
+
+    /**
+     * Parse a number written as text (I and R formats) with strtol.
+     * @param stringView The value, it needn't be zero terminated.
+     */
+    const long DDFTextToLong(const DDFStringView &stringView) noexcept;
+
+    /**
+     * Parse a number written as text (I and R formats) with strtod.
+     * @param stringView The value, it needn't be zero terminated.
+     */
+    const double DDFTextToDouble(const DDFStringView &stringView) noexcept;
+
+    /**
+     * A subfield of a field definition resolved once by name.  Extracting a
+     * subfield through a handle doesn't compare any names.
+     * @see DDFModule::FindSubfieldHandle(), DDFField::GetSubfieldAsLong()
+     */
+    struct DDFSubfieldHandle {
+        /**
+         * Definition of the field holding the subfield.
+         */
+        const DDFFieldDefining *fieldDefining = nullptr;
+        /**
+         * Definition of the subfield, nullptr if the subfield wasn't found.
+         */
+        const DDFSubfieldDefining *subfieldDefining = nullptr;
+        /**
+         * Index of the subfield in the field definition.
+         */
+        size_t subfieldIdx = 0ul;
+        /**
+         * Offset of the subfield from the start of a repeat, only set when
+         * all the subfields before it have a fixed width.
+         */
+        size_t subfieldOffset = 0ul;
+        bool isFixedOffset = false;
+
+        /**
+         * Check if the subfield was found.
+         */
+        const bool IsValid() const noexcept { return subfieldDefining != nullptr; }
+    };
+
+    /**
+     * The field definitions read from one data descriptive record (DDR).
+     * Immutable once built, and shared through a process wide cache by all the
+     * modules opened with a byte identical DDR, as the cells of an exchange set are.
+     */
+    class DDFDescriptiveRecord {
+        /**
+         * Open addressing slot of the field tag table.
+         */
+        struct DDFTagSlot {
+            DDFTag fieldTag = 0u;
+            const DDFFieldDefining *fieldDefining = nullptr;
+        };
+
+        /**
+         * Field definitions in DDR order, owned by the record, and a power of
+         * two table of the packed ones, probed linearly.
+         */
+        vector<DDFFieldDefining*> fieldDefinings;
+        vector<DDFTagSlot> tagTable;
+        uint tagTableShift = 32u;
+
+        /**
+         * The DDR bytes, leader included, the cache compares them on lookup.
+         */
+        string recordData;
+        size_t recordHash = 0ul;
+
+    public:
+        /**
+         * The constructor.
+         */
+        DDFDescriptiveRecord() noexcept : fieldDefinings(), tagTable(), recordData() {}
+
+        /**
+         * Fetch the definition of the named field.
+         * @param fieldName The name of the field to search for.
+         * @return A pointer to the field definition, or nullptr if none matching the name is found.
+         */
+        const DDFFieldDefining *FindFieldDefining(const string &fieldName) const noexcept;
+
+        /**
+         * Fetch the definition of a field by it's packed tag.
+         * @param fieldTag The tag packed with DDFPackTag().
+         * @return A pointer to the field definition, or nullptr if none matching the tag is found.
+         */
+        const DDFFieldDefining *FindFieldDefining(const DDFTag &fieldTag) const noexcept;
+
+        /**
+         * Fetch the number of defined fields.
+         */
+        const size_t GetFieldCount() const noexcept { return fieldDefinings.size(); }
+
+        /**
+         * The destructor.
+         */
+        ~DDFDescriptiveRecord() noexcept;
+
+        /**
+         * Delete standart realization
+         */
+        DDFDescriptiveRecord(const DDFDescriptiveRecord&) = delete;
+        DDFDescriptiveRecord(const DDFDescriptiveRecord&&) = delete;
+        DDFDescriptiveRecord& operator = (const DDFDescriptiveRecord&) = delete;
+        DDFDescriptiveRecord& operator = (const DDFDescriptiveRecord&&) = delete;
+
+        /**
+         * Friend classes
+         */
+        friend class DDFModule;
+    private:
+        void AddFieldDefining(DDFFieldDefining *fieldDefining) noexcept;
+        void BuildTagTable() noexcept;
+    };
+
     /**
      * The primary class for reading ISO 8211 (DDF) files.  This class contains all
      * the information read from the DDR record, and is used to read records
-     * from the file.
+     * from the file.  It has a single read position, several threads read one
+     * module through a DDFReader each.
+     * @see DDFReader
      */
     class DDFModule {
-        stringstream DDFfileBuf;
+        DDFopenMode openMode = DDF_OM_BUFFERED;
+
+        const byte *fileData = nullptr;
+        size_t fileSize = 0ul;
+        size_t fileOffset = 0ul;
         size_t firstRecordOffset = 0ul;
 
+        bool isStreamOwner = false;
+        istream *inputStream = nullptr;
+        streampos streamOrigin = streampos(-1);
+
+        byte *streamBuffer = nullptr;
+        size_t streamCapacity = 0ul;
+
         char interchangeLevel = 0;
         char inlineCodeExrensionIndicator = 0;
         char versionNumber = 0;
@@ -98,15 +497,21 @@ namespace Standards {
         uint sizeFieldPosition = 0u;
         char leaderIdentifier = 0;
 
+        bool isLazyDirectory = false;
+
+        bool isIndexComplete = false;
+        size_t indexedOffset = 0ul;
+        vector<DDFRecordIndexEntry> recordIndex;
+
         DDFRecord *currentRecord = nullptr;
-        map<string, DDFFieldDefining*> fieldDefinings;
+        shared_ptr<const DDFDescriptiveRecord> descriptiveRecord;
 		char extendedCharSet[4] = { '\0', '\0', '\0', '\0' };
 
     public:
         /**
          * The constructor.
          */
-        DDFModule() noexcept : DDFfileBuf(), fieldDefinings() {}
+        DDFModule() noexcept : recordIndex(), descriptiveRecord() {}
 
         /**
          * Open a ISO 8211 (DDF) file for reading.
@@ -115,24 +520,108 @@ namespace Standards {
          * read, and all the field and subfield definitions will be available.
          *
          * @param fileName The name of the file to open.
+         * @param testOpen Don't report a warning if the file can't be opened.
+         * @param openMode The way the file contents are accessed. In DDF_OM_MAPPED mode
+         * records read by ReadRecord() refer directly to the mapped file, no bytes are copied.
+         * @return false if the open fails.
+         * @see DDFopenMode
+         */
+        const bool Open(const string &fileName, const bool testOpen = false, const DDFopenMode openMode = DDF_OM_BUFFERED) noexcept;
+
+        /**
+         * Open a ISO 8211 (DDF) stream for reading in DDF_OM_STREAMED mode.
+         *
+         * The stream may be a pipe or the standard input, it is only read forward.
+         * The stream is not owned by the module and must outlive it or the next Close().
+         *
+         * @param inputStream The stream to read from.
+         * @param bufferSize The initial size of the refillable buffer. The buffer only
+         * grows if a single record is larger than it.
          * @return false if the open fails.
          */
-        const bool Open(const string &fileName, const bool testOpen = false) noexcept;
+        const bool Open(istream &inputStream, const size_t bufferSize = DDF_STREAM_BUFFER_SIZE) noexcept;
 
         /**
          * Read one record from the file.
          * @warning The returned record is owned by the module, and should not be deleted
          * by the application.  The record is only valid untill the next ReadRecord()
-         * at which point it is overwritten.
+         * at which point it is overwritten.  It's storage is reused, so once it has
+         * grown to the largest record read nothing is allocated in DDF_OM_STREAMED
+         * mode.  In the other modes the first sequential pass also appends to the
+         * record index, which grows by amortised doubling; once the index is complete
+         * (BuildIndex(), LoadIndex() or a whole pass) reading allocates nothing.
          * @return A pointer to a DDFRecord object is returned, or nullptr if a read
          * error, or end of file occurs.
          */
         const DDFRecord *ReadRecord() noexcept;
 
+        /**
+         * Read the record with the given number.  The record index is built
+         * first if it doesn't cover the record yet, afterwards the call is O(1).
+         * The next ReadRecord() continues from the record following this one.
+         * @warning Not available in DDF_OM_STREAMED mode.
+         * @param recordIdx The index of the data record, the DDR is not counted.
+         * @return A pointer to a DDFRecord object is returned, or nullptr if the
+         * index is out of range or a read error occurs.
+         * @see ReadRecord()
+         */
+        const DDFRecord *ReadRecord(const size_t &recordIdx) noexcept;
+
+        /**
+         * Read the next record selected by a filter.  The records in between are
+         * only checked against the tags of their raw directory, no field of them
+         * is built.  The record index is filled as with ReadRecord().
+         * @param recordFilter The tags to select the records by.
+         * @return A pointer to a DDFRecord object is returned, or nullptr if a read
+         * error, or end of file occurs.
+         * @see DDFRecordFilter
+         */
+        const DDFRecord *ReadRecord(const DDFRecordFilter &recordFilter) noexcept;
+
+        /**
+         * Complete the record index (record number to offset, length and first
+         * field tag).  The index is also filled on the fly while records are read
+         * sequentially from the start, so this only scans the leaders not seen yet.
+         * @warning Not available in DDF_OM_STREAMED mode.  The index stops at a record
+         * whose leader and directory are reused, the records after it have no leader.
+         * @return false if the index can't be built.
+         */
+        const bool BuildIndex() noexcept;
+
+        /**
+         * Gets the record index, it is complete only after BuildIndex().
+         * @see DDFRecordIndexEntry
+         */
+        const vector<DDFRecordIndexEntry> &GetRecordIndex() const noexcept { return recordIndex; }
+
+        /**
+         * Find all records whose first data field has the given tag.
+         * @param fieldName The tag of the field, e.g. "VRID" or "FRID".
+         * @return The record numbers in file order, usable with ReadRecord(recordIdx).
+         */
+        vector<size_t> FindRecords(const string &fieldName) noexcept;
+
+        /**
+         * Save the complete record index into a sidecar file.
+         * @param indexName The name of the sidecar file.
+         * @return false if the index can't be built or written.
+         */
+        const bool SaveIndex(const string &indexName) noexcept;
+
+        /**
+         * Load the record index from a sidecar file written by SaveIndex().
+         * The sidecar is rejected if it doesn't match the open file.
+         * @param indexName The name of the sidecar file.
+         * @return false if the sidecar is missing or doesn't match.
+         */
+        const bool LoadIndex(const string &indexName) noexcept;
+
         /**
          * Return to the first record.
          *
          * @warning The next call to ReadRecord() will read the first data record in the file.
+         * In DDF_OM_STREAMED mode this requires a seekable stream.  A reused leader and
+         * directory are forgotten, the first record supplies them again.
          */
         void Rewind() noexcept;
 
@@ -145,6 +634,23 @@ namespace Standards {
          */
         const DDFFieldDefining *FindFieldDefining(const string &fieldName) const noexcept;
 
+        /**
+         * Fetch the definition of a field by it's packed tag, without building any string.
+         * @param fieldTag The tag packed with DDFPackTag().
+         * @return A pointer to the field definition, or nullptr if none matching the tag is found.
+         */
+        const DDFFieldDefining *FindFieldDefining(const DDFTag &fieldTag) const noexcept;
+
+        /**
+         * Resolve a subfield of the named field once, to extract it later without
+         * any name lookup.
+         * @param fieldName The name of the field.
+         * @param subfieldName The mnemonic tag of the subfield.
+         * @return The handle, invalid if there isn't any such field or subfield.
+         * @see DDFSubfieldHandle
+         */
+        const DDFSubfieldHandle FindSubfieldHandle(const string &fieldName, const string &subfieldName) const noexcept;
+
         /**
          * Close an ISO 8211 (DDF) file.
          */
@@ -153,7 +659,38 @@ namespace Standards {
         /**
          * Fetch the number of defined fields.
          */
-        const size_t GetFieldCount() const noexcept { return fieldDefinings.size(); }
+        const size_t GetFieldCount() const noexcept { return descriptiveRecord ? descriptiveRecord->GetFieldCount() : 0ul; }
+
+        /**
+         * Release the field definitions cached for DDRs already read.  Modules
+         * still open keep theirs.
+         * @see DDFDescriptiveRecord
+         */
+        static void ClearDescriptiveCache() noexcept;
+
+        /**
+         * Gets the way the file contents are accessed.
+         * @see DDFopenMode
+         */
+        const DDFopenMode GetOpenMode() const noexcept { return openMode; }
+
+        /**
+         * Decode the field directory of the records lazily.  A record then keeps
+         * it's raw directory, and builds a field only when it is asked for by
+         * GetField() or FindField().  Records that are mostly skipped after a look
+         * at their first data field are much cheaper to read this way.
+         * @warning A corrupt directory entry no longer fails the whole record, the
+         * field is reported when requested and GetField() returns nullptr for it.
+         * Records whose leader and directory are reused are always decoded at once.
+         * @param isLazy true to decode the directories lazily, false by default.
+         */
+        void SetLazyDirectory(const bool isLazy) noexcept { isLazyDirectory = isLazy; }
+
+        /**
+         * Check if the field directory of the records is decoded lazily.
+         * @see SetLazyDirectory()
+         */
+        const bool IsLazyDirectory() const noexcept { return isLazyDirectory; }
 
         /**
          * Fetch the definition of the named field.
@@ -181,6 +718,14 @@ namespace Standards {
          * Friend classes
          */
         friend class DDFRecord;
+        friend class DDFReader;
+    private:
+        const bool ReadDescriptiveRecord(const string &fileName) noexcept;
+        const bool IndexRecord(const size_t &recordOffset) noexcept;
+        const size_t LoadData(const size_t &byteCount) noexcept;
+
+        static const shared_ptr<const DDFDescriptiveRecord> FindDescriptiveRecord(const byte *recordData, const size_t &recordLenght, const size_t &recordHash) noexcept;
+        static const shared_ptr<const DDFDescriptiveRecord> CacheDescriptiveRecord(const shared_ptr<const DDFDescriptiveRecord> &newRecord) noexcept;
     };
 
     typedef enum : byte {
@@ -206,6 +751,83 @@ namespace Standards {
         DDF_TES_LEVEL2
     } DDFtruncatedEscapeSequence;
 
+    typedef enum : byte {
+        DDF_BF_NOT_BINARY = 0u,
+        DDF_BF_UINT,
+        DDF_BF_SINT,
+        DDF_BF_FP_REAL,
+        DDF_BF_FLOAT_REAL,
+        DDF_BF_FLOAT_COMPLEX
+    } DDFbinaryFormat;
+
+    typedef enum : byte {
+        DDF_DT_INT = 0u,
+        DDF_DT_FLOAT,
+        DDF_DT_STRING,
+        DDF_DT_BINARY_STRING
+    } DDFdataType;
+
+    typedef enum : byte {
+        DDF_OP_SKIP = 0u,
+        DDF_OP_TEXT,
+        DDF_OP_TEXT_INT,
+        DDF_OP_TEXT_FLOAT,
+        DDF_OP_BIT_STRING,
+        DDF_OP_UINT8,
+        DDF_OP_UINT16,
+        DDF_OP_UINT32,
+        DDF_OP_SINT8,
+        DDF_OP_SINT16,
+        DDF_OP_SINT32,
+        DDF_OP_FLOAT32,
+        DDF_OP_FLOAT64
+    } DDFdecodeOpcode;
+
+    /**
+     * One step of the decode plan of a field, compiled from the format
+     * controls of a subfield.  Binary values are little endian.
+     * @see DDFFieldDefining::GetDecodePlan()
+     */
+    struct DDFDecodeOp {
+        /**
+         * What to read, DDF_OP_SKIP only consumes the bytes of an unsupported format.
+         */
+        DDFdecodeOpcode opcode = DDF_OP_SKIP;
+        /**
+         * How the value is interpreted.
+         */
+        DDFdataType dataType = DDF_DT_STRING;
+        /**
+         * Width in bytes, zero for a variable width value.
+         */
+        size_t width = 0ul;
+        /**
+         * Whether the value runs up to a unit terminator, as for
+         * DDFSubfieldDefining::GetDataLenght().
+         */
+        bool isVariable = false;
+        /**
+         * The subfield the operation was compiled from.
+         */
+        const DDFSubfieldDefining *subfieldDefining = nullptr;
+    };
+
+    /**
+     * The value of one subfield, filled by a decode plan.
+     * @see DDFFieldDefining::DecodeField()
+     */
+    struct DDFSubfieldValue {
+        /**
+         * Numeric value, zero for strings and bit strings.
+         */
+        long longValue = 0l;
+        double doubleValue = 0.0;
+        /**
+         * The raw subfield bytes, terminator excluded, pointing into the record.
+         */
+        DDFBinaryView binaryData;
+    };
+
     /**
      * Information from the DDR defining one field.  Note that just because
      * a field is defined for a DDFModule doesn't mean that it actually occurs
@@ -214,6 +836,7 @@ namespace Standards {
      */
     class DDFFieldDefining {
         char* tagName = nullptr;
+        DDFTag fieldTag = 0u;
         char* fieldName = nullptr;
 
         DDFdataTypeCode dataTypeCode = DDF_DTC_MIXED_DATA_TYPE;
@@ -225,11 +848,22 @@ namespace Standards {
 
         vector<DDFSubfieldDefining*> subfieldDefinings;
 
+        /**
+         * Offset of each subfield from the start of a repeat, only built
+         * when the field has a fixed width.
+         */
+        vector<size_t> subfieldOffsets;
+
+        /**
+         * One operation per subfield, compiled once from the format controls.
+         */
+        vector<DDFDecodeOp> decodePlan;
+
     public:
         /**
          * The constructor.
          */
-        DDFFieldDefining() noexcept : subfieldDefinings(0) {}
+        DDFFieldDefining() noexcept : subfieldDefinings(0), subfieldOffsets(), decodePlan() {}
 
         /**
          * Fetch a subfield by index.
@@ -245,12 +879,25 @@ namespace Standards {
          */
         const DDFSubfieldDefining* FindSubfieldDefining(const string& mnemonicTag) const noexcept;
 
+        /**
+         * Resolve a subfield by it's mnemonic tag.
+         * @param mnemonicTag The name of the subfield.
+         * @return The handle, invalid if there isn't any such subfield.
+         * @see DDFSubfieldHandle
+         */
+        const DDFSubfieldHandle GetSubfieldHandle(const string& mnemonicTag) const noexcept;
+
         /**
          * Gets a pointer to the field name (tag).
          * @warning this is an internal copy and shouldn't be freed.
          */
         const string GetName() const noexcept { return tagName; }
 
+        /**
+         * Gets the field tag packed with DDFPackTag(), 0 if the tag is too long to be packed.
+         */
+        const DDFTag GetTag() const noexcept { return fieldTag; }
+
         /**
          * Gets a longer description of this field.
          * @warning this is an internal copy and shouldn't be freed.
@@ -278,6 +925,28 @@ namespace Standards {
          */
         const size_t GetFixedWidth() const noexcept { return fixedWidth; }
 
+        /**
+         * Get the offset of a subfield from the start of a repeat.
+         * @param idx The index subfield index. (Between 0 and GetSubfieldCount()-1)
+         * @return The offset in bytes, only meaningful when GetFixedWidth() isn't zero.
+         */
+        const size_t GetSubfieldOffset(const ulong& idx) const noexcept { return idx < subfieldOffsets.size() ? subfieldOffsets[idx] : 0ul; }
+
+        /**
+         * Gets the decode plan, one operation per subfield in subfield order.
+         */
+        const vector<DDFDecodeOp> &GetDecodePlan() const noexcept { return decodePlan; }
+
+        /**
+         * Decode every subfield of one repeat of this field in a single pass
+         * over the decode plan, without any format interpretation.
+         * @param sourceData The start of the repeat.
+         * @param dataSize The number of bytes accessable after sourceData.
+         * @param values Receives GetSubfieldCount() values, in subfield order.
+         * @return The number of bytes consumed by the repeat, terminators included.
+         */
+        const size_t DecodeField(const byte *sourceData, const size_t &dataSize, DDFSubfieldValue *values) const noexcept;
+
         /**
          * Fetch a subfield by index.
          * @param idx The index subfield index. (Between 0 and GetSubfieldCount()-1)
@@ -318,24 +987,9 @@ namespace Standards {
 
     private:
         bool BuildSubfields(const char*& descriptorArray, const size_t& descriptorArrayLenght, const char*& formatControls, const size_t& formatControlsLenght) noexcept;
+        void BuildDecodePlan() noexcept;
     };
 
-    typedef enum : byte {
-        DDF_BF_NOT_BINARY = 0u,
-        DDF_BF_UINT,
-        DDF_BF_SINT,
-        DDF_BF_FP_REAL,
-        DDF_BF_FLOAT_REAL,
-        DDF_BF_FLOAT_COMPLEX
-    } DDFbinaryFormat;
-
-    typedef enum : byte {
-        DDF_DT_INT = 0u,
-        DDF_DT_FLOAT,
-        DDF_DT_STRING,
-        DDF_DT_BINARY_STRING
-    } DDFdataType;
-
     /**
      * Information from the DDR record describing one subfield of a DDFFIeldDefining.
      * All subfields of a field will occur in each occurance of that field
@@ -453,7 +1107,21 @@ namespace Standards {
          * @return A pointer to a buffer containing the data for this field.
          * @see ExtractDataAsLong, ExtractDataAsDouble, ExtractDataAsString
          */
-        const byte* ExtractDataAsBinary(const byte* sourceData, const size_t& dataSize, size_t* consumedBytes = nullptr) const noexcept;
+        const byte* ExtractDataAsBinary(const byte* sourceData, const size_t& dataSize, size_t* consumedBytes = nullptr) const noexcept;
+
+        /**
+         * Same as ExtractDataAsString(), but returns a view on the source data
+         * instead of a new copy.  The terminator isn't part of the view.
+         * @see ExtractDataAsString()
+         */
+        const DDFStringView ExtractDataAsStringView(const byte* sourceData, const size_t& dataSize, size_t* consumedBytes = nullptr) const noexcept;
+
+        /**
+         * Same as ExtractDataAsBinary(), but returns a view on the source data
+         * instead of a new copy.
+         * @see ExtractDataAsBinary()
+         */
+        const DDFBinaryView ExtractDataAsBinaryView(const byte* sourceData, const size_t& dataSize, size_t* consumedBytes = nullptr) const noexcept;
 
         /**
          * Scan for the end of variable length data.  Given a pointer to the data
@@ -491,6 +1159,16 @@ namespace Standards {
          */
         const ulong GetWidth() const noexcept { return formatWidth; }
 
+        /**
+         * Check if the value runs up to a unit terminator.
+         */
+        const bool IsVariable() const noexcept { return isVariable; }
+
+        /**
+         * Gets the format control character ('A', 'I', 'R', 'B' or 'b').
+         */
+        const byte GetFormat() const noexcept { return dataFormat; }
+
         /**
          * Check if subfields contained.
          * @return true if the field has subfields
@@ -536,6 +1214,223 @@ namespace Standards {
         bool BuildSubfields(const char* pachFieldArea, const char*& stringFormat) noexcept;
     };
 
+    /**
+     * This object represents one field in a DDFRecord.  This
+     * models an instance of the fields data, rather than it's data definition
+     * which is handled by the DDFFieldDefining class.  Note that a DDFField
+     * doesn't have DDFSubfield children as you would expect.  To extract
+     * subfield values use GetSubfieldData() to find the right data pointer and
+     * then use ExtractIntData(), ExtractFloatData() or ExtractStringData().
+     */
+    class DDFField {
+        size_t dataSize = 0ull;
+        const byte *binaryData = nullptr;
+
+        const DDFFieldDefining *fieldDefining = nullptr;
+
+        /**
+         * Start offset of each repeat of a variable width repeating field,
+         * built by a single forward scan the first time a repeat is accessed.
+         */
+        mutable bool isRepeatScanned = false;
+        mutable vector<size_t> repeatOffsets;
+    public:
+        /**
+         * The constructor.
+         * @param fieldDefining the pointer of DDFFieldDefining object.
+         * @param fieldEntrySize the size of the field.
+         * @param pachFieldArea associated binary data for this field
+         */
+        DDFField(const DDFFieldDefining *fieldDefining, const size_t fieldEntrySize, const byte *pachFieldArea) noexcept :
+            dataSize(fieldEntrySize), binaryData(pachFieldArea), fieldDefining(fieldDefining), repeatOffsets() {}
+
+        /**
+         * Gets the number of bytes in the data block.
+         * @see GetBinaryData()
+         */
+        const size_t GetDataSize() const noexcept { return dataSize; }
+
+        /**
+         * Gets the pointer to the entire data block for this field.
+         * @warning This is an internal copy, and shouldn't be freed by the application.
+         */
+        const byte* GetBinaryData() const noexcept { return binaryData; }
+
+        /**
+         * Gets value of a subfield as a long. This is a convenience
+         * function for fetching a subfield of a field within this record.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, or zero if it failed for some reason.
+         * @see GetSubfieldAsDouble, GetSubfieldAsString, GetSubfieldAsBinary
+         */
+        const long GetSubfieldAsLong(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a subfield as a double.  This is a convenience
+         * function for fetching a subfield of a field within this record.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, or zero if it failed for some reason.
+         * @see GetSubfieldAsLong, GetSubfieldAsString, GetSubfieldAsBinary
+         */
+        const double GetSubfieldAsDouble(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a subfield as a string.  This is a convenience
+         * function for fetching a subfield of a field within this record.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, or nullptr if it failed for some reason.
+         * @see GetSubfieldAsDouble, GetSubfieldAsLong, GetSubfieldAsBinary
+         */
+        const char* GetSubfieldAsString(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a subfield as a string.  This is a convenience
+         * function for fetching a subfield of a field within this record.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, or nullptr if it failed for some reason.
+         * @warning The returned pointer is to internal data and should not be modified or
+         * freed by the application.
+         * @see GetSubfieldAsDouble, GetSubfieldAsLong, GetSubfieldAsString
+         */
+        const byte* GetSubfieldAsBinary(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a resolved subfield as a long.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, or zero if the handle belongs to an other field.
+         * @see DDFModule::FindSubfieldHandle()
+         */
+        const long GetSubfieldAsLong(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a resolved subfield as a double.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, or zero if the handle belongs to an other field.
+         * @see DDFModule::FindSubfieldHandle()
+         */
+        const double GetSubfieldAsDouble(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a resolved subfield as a string.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, or nullptr if the handle belongs to an other field.
+         * @see DDFModule::FindSubfieldHandle()
+         */
+        const char* GetSubfieldAsString(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a resolved subfield as raw data.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, or nullptr if the handle belongs to an other field.
+         * @warning The returned pointer is to internal data and should not be modified or
+         * freed by the application.
+         * @see DDFModule::FindSubfieldHandle()
+         */
+        const byte* GetSubfieldAsBinary(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a subfield as a view on the record data, nothing is copied.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, empty if it failed for some reason.
+         * It remains valid until the next record read.
+         * @see GetSubfieldAsString
+         */
+        const DDFStringView GetSubfieldAsStringView(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets value of a resolved subfield as a view on the record data, nothing is copied.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, empty if the handle belongs to an other field.
+         * It remains valid until the next record read.
+         * @see GetSubfieldAsString
+         */
+        const DDFStringView GetSubfieldAsStringView(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets the raw value of a subfield as a view on the record data, nothing is copied.
+         * Unlike GetSubfieldAsBinary() the view carries the size of the value.
+         * @param subfieldName The name of the subfield within the current field.
+         * @return The value of the subfield, empty if it failed for some reason.
+         * It remains valid until the next record read.
+         */
+        const DDFBinaryView GetSubfieldAsBinaryView(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets the raw value of a resolved subfield as a view on the record data, nothing is copied.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @return The value of the subfield, empty if the handle belongs to an other field.
+         * It remains valid until the next record read.
+         */
+        const DDFBinaryView GetSubfieldAsBinaryView(const DDFSubfieldHandle &subfieldHandle, const ulong fieldIdx = 0ul) const noexcept;
+
+        /**
+         * Gets the values of a resolved subfield in every repeat of this field as longs.
+         * For a fixed width field this is a single strided pass over the field data.
+         * @param subfieldHandle The subfield, resolved on the definition of this field.
+         * @param values Receives one value per repeat, it's storage is reused.
+         * @return The number of values, zero if the handle belongs to an other field.
+         * @see GetRepeatCount()
+         */
+        const size_t GetSubfieldAsLongArray(const DDFSubfieldHandle &subfieldHandle, vector<long> &values) const noexcept;
+
+        /**
+         * Decode all the subfields of all the repeats of this field, one decode
+         * plan pass per repeat.
+         * @param values Receives GetRepeatCount() * GetSubfieldCount() values, repeat
+         * after repeat, a subfield value is at repeatIdx * GetSubfieldCount() + subfieldIdx.
+         * It's storage is reused.
+         * @return The number of repeats decoded.
+         * @see DDFFieldDefining::DecodeField()
+         */
+        const size_t DecodeRepeats(vector<DDFSubfieldValue> &values) const noexcept;
+
+        /**
+         * How many times do the subfields of this record repeat?  This
+         * will always be one for non-repeating fields.
+         *
+         * @return The number of times that the subfields of this record occur
+         * in this record.  This will be one for non-repeating fields.
+         */
+        const size_t GetRepeatCount() const noexcept;
+
+        /**
+         * Gets the data of one repeat of this field.  For a variable width field
+         * the repeats are located once, later calls are constant time.
+         * @param fieldIdx The repeat to fetch. (Between 0 and GetRepeatCount()-1)
+         * @param byteLeft Receives the number of bytes from the repeat to the end of the field.  May be nullptr.
+         * @return A pointer to the first subfield of the repeat, or nullptr if the index is out of range.
+         */
+        const byte* GetRepeatData(const ulong &fieldIdx, size_t *byteLeft = nullptr) const noexcept;
+
+        /**
+         * Gets the corresponding DDFFieldDefining.
+         */
+        const DDFFieldDefining* GetFieldDefining() const noexcept { return fieldDefining; }
+
+         /**
+          * Destructor
+          */
+         ~DDFField() noexcept = default;
+
+        /**
+         * A field is only a view on the record data, so it is cheap to copy
+         * and DDFRecord keeps them by value.
+         */
+        DDFField(const DDFField&) noexcept = default;
+        DDFField& operator = (const DDFField&) noexcept = default;
+
+        /**
+         * Friend classes
+         */
+        friend class DDFRecord;
+    private:
+        void Initialize(const DDFFieldDefining *fieldDefining, const size_t fieldEntrySize, const byte *pachFieldArea) noexcept;
+        void ScanRepeats() const noexcept;
+        const size_t GetRepeatOffset(const ulong &fieldIdx) const noexcept;
+        const byte* GetBinaryData(const DDFSubfieldDefining *&subfieldDef, const ulong &fieldIdx, size_t *byteLeft = nullptr) const noexcept;
+        const byte* GetBinaryData(const DDFSubfieldHandle &subfieldHandle, const ulong &fieldIdx, size_t *byteLeft = nullptr) const noexcept;
+    };
+
     /**
      * Contains instance data from one data record (DR).  The data is contained
      * as a list of DDFField instances partitioning the raw data into fields.
@@ -544,23 +1439,67 @@ namespace Standards {
         bool isClone = false;
         bool isReuseHeader = false;
 
-        DDFModule& parentModule;
+        const DDFModule& parentModule;
+
+        /**
+         * The read position the record advances: the module's own, then cursorModule
+         * is the module and loads the data and fills the record index, or the one of
+         * a DDFReader, then cursorModule is nullptr and the module is only read.
+         */
+        DDFModule *cursorModule = nullptr;
+        size_t *readOffset = nullptr;
 
         ulong dataSize = 0ul;
-        byte *binaryData = nullptr;
+        const byte *binaryData = nullptr;
+
+        /**
+         * The fields are kept by value and the storage is reused from one record
+         * to the next, only the first fieldCount entries belong to the current record.
+         */
+        size_t fieldCount = 0ul;
+        mutable vector<DDFField> fields;
+
+        /**
+         * Geometry of the directory of the current record, the directory starts
+         * at binaryData.  With a lazy directory each entry is decoded the first
+         * time it's field is requested, fieldStates tells which ones are.
+         * @see DDFModule::SetLazyDirectory()
+         */
+        bool isLazyDirectory = false;
+        size_t fieldAreaStart = 0ul;
+        size_t sizeFieldLenght = 0ul;
+        size_t sizeFieldPosition = 0ul;
+        size_t sizeFieldTag = 0ul;
+        size_t fieldEntryWidth = 0ul;
+        mutable vector<DDFdirectoryEntryState> fieldStates;
 
-        vector<DDFField*> fields;
+        /**
+         * Layout kept from a record whose leader and directory are reused ('R'
+         * leader identifier): the size of the field area and the offset of each
+         * field in it.  The following records are only a field area each.
+         */
+        size_t fieldAreaSize = 0ul;
+        vector<size_t> fieldOffsets;
+
+        /**
+         * Whether the record supplying a reused leader and directory was selected
+         * by the filter of the read, then all the records following it are.
+         */
+        bool isReuseSelected = true;
     public:
         /**
          * The constructor.
          * @param parentModule The reference of DDFModule object.
          */
-        DDFRecord(DDFModule &parentModule) noexcept : parentModule(parentModule), fields() { }
+        DDFRecord(DDFModule &parentModule) noexcept : DDFRecord(parentModule, &parentModule, &parentModule.fileOffset) { }
 
         /**
          * Fetch field object based on index.
          * @param idx The index of the field to fetch.  Between 0 and GetFieldCount()-1.
-         * @return A DDFField pointer, or nullptr if the index is out of range.
+         * @return A DDFField pointer, or nullptr if the index is out of range or,
+         * with a lazy directory, the directory entry of the field is corrupt.
+         * @warning With a lazy directory the field is built on the first request, a
+         * record must then not be used from several threads at once.
          */
         const DDFField* GetField(const ulong &idx) const;
 
@@ -576,10 +1515,18 @@ namespace Standards {
          */
         const DDFField *FindField(const string &fieldName) const;
 
+        /**
+         * Find the field of the given definition within this record.
+         * @param fieldDefining The definition of the field, e.g. from a DDFSubfieldHandle.
+         * @return Pointer to the requested DDFField, or nullptr if the record doesn't have one.
+         * It remains valid until the next record read.
+         */
+        const DDFField *FindField(const DDFFieldDefining *fieldDefining) const noexcept;
+
         /**
          * Get the number of DDFFields on this record.
          */
-        const size_t GetFieldCount() const noexcept { return fields.size(); }
+        const size_t GetFieldCount() const noexcept { return fieldCount; }
 
         /**
          * Make a copy of a record.
@@ -601,7 +1548,10 @@ namespace Standards {
         /**
          * Fetch the raw data for this record.  The returned pointer is effectively
          * to the data for the first field of the record, and is of size
-         * @see GetDataSize().
+         * @see GetDataSize().  For a record read with a reused leader and directory
+         * it is the field area only.
+         * @warning Unless the record is a clone, this points into the file data
+         * of the DDFModule and is only valid untill the next ReadRecord().
          */
         const byte *GetBinaryData() const noexcept { return binaryData; }
 
@@ -610,6 +1560,25 @@ namespace Standards {
          */
         const DDFModule &GetModule() const noexcept { return parentModule; }
 
+        /**
+         * Read the record described by an index entry, leaving the read position of
+         * the module untouched.  Several records of one module may read at once this
+         * way, e.g. one per worker thread.
+         * @warning Not available in DDF_OM_STREAMED mode.
+         * @param recordEntry The entry of the record in the module's record index.
+         * @return false if the record can't be read.
+         * @see DDFModule::GetRecordIndex()
+         */
+        bool Read(const DDFRecordIndexEntry &recordEntry) noexcept;
+
+        /**
+         * Read the next record of the module selected by a filter, skipping the others.
+         * @param recordFilter The tags to select the records by.
+         * @return false if there isn't any more selected record or it can't be read.
+         * @see DDFModule::ReadRecord(const DDFRecordFilter&)
+         */
+        bool Read(const DDFRecordFilter &recordFilter) noexcept;
+
         /**
          * The destructor.
          */
@@ -627,115 +1596,94 @@ namespace Standards {
          * Friend classes
          */
         friend class DDFModule;
+        friend class DDFReader;
     private:
+        DDFRecord(const DDFModule &parentModule, DDFModule *cursorModule, size_t *readOffset) noexcept :
+            parentModule(parentModule), cursorModule(cursorModule), readOffset(readOffset), fields(), fieldStates(), fieldOffsets() { }
+
         void Clear();
         bool Read();
 
         bool ReadHeader();
+        bool LoadRecord(const byte **recordData, size_t *recordLenght);
+        const size_t LoadData(const size_t &byteCount) const noexcept;
+        bool ReadFieldArea();
+        bool ParseHeader(const byte *recordData, const size_t &recordLenght);
+
+        const DDFField *LoadField(const size_t &idx) const noexcept;
+        const bool MatchDirectoryTag(const size_t &idx, const DDFTag &fieldTag, const string &fieldName) const noexcept;
+        const DDFFieldDefining *ReadDirectoryEntry(const size_t &idx, size_t *fieldLenght, size_t *fieldOffset) const noexcept;
     };
 
     /**
-     * This object represents one field in a DDFRecord.  This
-     * models an instance of the fields data, rather than it's data definition
-     * which is handled by the DDFFieldDefining class.  Note that a DDFField
-     * doesn't have DDFSubfield children as you would expect.  To extract
-     * subfield values use GetSubfieldData() to find the right data pointer and
-     * then use ExtractIntData(), ExtractFloatData() or ExtractStringData().
+     * A read position of it's own over an open module.  The module holds only the
+     * state that doesn't change once it is open (DDR, field definitions, file data),
+     * so any number of readers, e.g. one per thread, may iterate or random access
+     * the records of one module at once without any lock.
+     * @warning Not available in DDF_OM_STREAMED mode.  The module must stay open, and
+     * must not be read through it's own ReadRecord() meanwhile, which fills the record
+     * index.  ReadRecord(recordIdx) only reaches the records already indexed, so the
+     * index is completed with DDFModule::BuildIndex() before the readers start.
      */
-    class DDFField {
-        size_t dataSize = 0ull;
-        const byte *binaryData = nullptr;
-
-        const DDFFieldDefining *fieldDefining = nullptr;
-    public:
-        /**
-         * The constructor.
-         * @param fieldDefining the pointer of DDFFieldDefining object.
-         * @param fieldEntrySize the size of the field.
-         * @param pachFieldArea associated binary data for this field
-         */
-        DDFField(const DDFFieldDefining *fieldDefining, const size_t fieldEntrySize, const byte *pachFieldArea) noexcept :
-            dataSize(fieldEntrySize), binaryData(pachFieldArea), fieldDefining(fieldDefining) {}
-
-        /**
-         * Gets the number of bytes in the data block.
-         * @see GetBinaryData()
-         */
-        const size_t GetDataSize() const noexcept { return dataSize; }
+    class DDFReader {
+        const DDFModule &parentModule;
 
-        /**
-         * Gets the pointer to the entire data block for this field.
-         * @warning This is an internal copy, and shouldn't be freed by the application.
-         */
-        const byte* GetBinaryData() const noexcept { return binaryData; }
+        size_t fileOffset = 0ul;
+        DDFRecord currentRecord;
 
+    public:
         /**
-         * Gets value of a subfield as a long. This is a convenience
-         * function for fetching a subfield of a field within this record.
-         * @param subfieldName The name of the subfield within the current field.
-         * @return The value of the subfield, or zero if it failed for some reason.
-         * @see GetSubfieldAsDouble, GetSubfieldAsString, GetSubfieldAsBinary
+         * The constructor, the reader starts at the first data record.
+         * @param parentModule The open module to read from.
          */
-        const long GetSubfieldAsLong(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+        explicit DDFReader(const DDFModule &parentModule) noexcept;
 
         /**
-         * Gets value of a subfield as a double.  This is a convenience
-         * function for fetching a subfield of a field within this record.
-         * @param subfieldName The name of the subfield within the current field.
-         * @return The value of the subfield, or zero if it failed for some reason.
-         * @see GetSubfieldAsLong, GetSubfieldAsString, GetSubfieldAsBinary
+         * Read the next record.
+         * @warning The returned record is owned by the reader, and is only valid
+         * untill the next read through this reader.
+         * @return A pointer to the record, or nullptr if a read error, or end of file occurs.
+         * @see DDFModule::ReadRecord()
          */
-        const double GetSubfieldAsDouble(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+        const DDFRecord *ReadRecord() noexcept;
 
         /**
-         * Gets value of a subfield as a string.  This is a convenience
-         * function for fetching a subfield of a field within this record.
-         * @param subfieldName The name of the subfield within the current field.
-         * @return The value of the subfield, or nullptr if it failed for some reason.
-         * @see GetSubfieldAsDouble, GetSubfieldAsLong, GetSubfieldAsBinary
+         * Read the record with the given number from the module's record index.
+         * The next ReadRecord() continues from the record following this one.
+         * @param recordIdx The index of the data record, the DDR is not counted.
+         * @return A pointer to the record, or nullptr if the record isn't indexed
+         * or a read error occurs.
+         * @see DDFModule::ReadRecord(const size_t&)
          */
-        const char* GetSubfieldAsString(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+        const DDFRecord *ReadRecord(const size_t &recordIdx) noexcept;
 
         /**
-         * Gets value of a subfield as a string.  This is a convenience
-         * function for fetching a subfield of a field within this record.
-         * @param subfieldName The name of the subfield within the current field.
-         * @return The value of the subfield, or nullptr if it failed for some reason.
-         * @warning The returned pointer is to internal data and should not be modified or
-         * freed by the application.
-         * @see GetSubfieldAsDouble, GetSubfieldAsLong, GetSubfieldAsString
+         * Read the next record selected by a filter.
+         * @param recordFilter The tags to select the records by.
+         * @return A pointer to the record, or nullptr if a read error, or end of file occurs.
+         * @see DDFModule::ReadRecord(const DDFRecordFilter&)
          */
-        const byte* GetSubfieldAsBinary(const string &sufieldName, const ulong fieldIdx = 0ul) const noexcept;
+        const DDFRecord *ReadRecord(const DDFRecordFilter &recordFilter) noexcept;
 
         /**
-         * How many times do the subfields of this record repeat?  This
-         * will always be one for non-repeating fields.
-         *
-         * @return The number of times that the subfields of this record occur
-         * in this record.  This will be one for non-repeating fields.
+         * Return to the first record.
          */
-        const size_t GetRepeatCount() const noexcept;
+        void Rewind() noexcept;
 
         /**
-         * Gets the corresponding DDFFieldDefining.
+         * Fetch the DDFModule this reader reads from.
          */
-        const DDFFieldDefining* GetFieldDefining() const noexcept { return fieldDefining; }
-
-         /**
-          * Destructor
-          */
-         ~DDFField() noexcept = default;
+        const DDFModule &GetModule() const noexcept { return parentModule; }
 
         /**
          * Delete standart realization
          */
-        DDFField(const DDFField&) = delete;
-        DDFField(const DDFField&&) = delete;
-        DDFField& operator = (const DDFField&) = delete;
-        DDFField& operator = (const DDFField&&) = delete;
-
+        DDFReader(const DDFReader&) = delete;
+        DDFReader(const DDFReader&&) = delete;
+        DDFReader& operator = (const DDFReader&) = delete;
+        DDFReader& operator = (const DDFReader&&) = delete;
     private:
-        const byte* GetBinaryData(const DDFSubfieldDefining *&subfieldDef, const ulong &fieldIdx, size_t *byteLeft = nullptr) const noexcept;
+        const bool IsReadable() const noexcept;
     };
 }
 #endif /* defined(__Standards__iso8211__) */
@@ -20,6 +20,8 @@ using namespace std::chrono;
 //#define FILE_OUTPUT_NAME "out.txt"
 
 int main(int argc, const char * argv[]) {
+    DDFDiagnostics::SetMessageRate(100u);
+
     auto &&start = high_resolution_clock::now();
 
     ENCChart chart(FILE_INPUT_NAME);
@@ -46,6 +48,13 @@ int main(int argc, const char * argv[]) {
     file.close();
 #endif
     
+    vector<DDFDiagnostic> diagnostics;
+    DDFDiagnostics::Drain(diagnostics);
+
+    for (auto &&diagnostic : diagnostics) {
+        cout << "WARNING: " << diagnostic.message << '\n';
+    }
+
     cout << "Duration time: " << timeSpan.count() <<  " sec." << endl;
     
     return 0;